@@ -0,0 +1,15 @@
+#version 330 core
+layout (location = 0) in vec4 aPosRadius;   // сфералармен ортақ slot буфері (радиус қолданылмайды)
+
+layout (std140) uniform Frame {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uEye;
+    vec4 uLightDir[2];
+    vec4 uLightColor[2];                    // rgb — диффуз, w — specular күші
+    vec4 uAmbient;
+};
+
+void main() {
+    gl_Position = uProj * uView * vec4(aPosRadius.xyz, 1.0);
+}
@@ -0,0 +1,51 @@
+#version 330 core
+in vec3 vQuadView;
+flat in vec3 vCenterView;
+flat in float vRadius;
+flat in vec3 vColor;
+
+layout (std140) uniform Frame {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uEye;
+    vec4 uLightDir[2];
+    vec4 uLightColor[2];                    // rgb — диффуз, w — specular күші
+    vec4 uAmbient;
+};
+layout (std140) uniform Materials {
+    vec4 uStateDiffuse[4];                  // NodeState бойынша
+    vec4 uSpecular;                         // rgb, w — shininess
+};
+
+out vec4 FragColor;
+
+// beginLighting()-тегі екі бағытталған жарық (key + fill), әлем кеңістігінде
+vec3 shade(vec3 base, vec3 N, vec3 V) {
+    vec3 c = base * uAmbient.rgb;
+    for (int i = 0; i < 2; ++i) {
+        vec3 L = uLightDir[i].xyz;
+        float d = max(dot(N, L), 0.0);
+        c += base * uLightColor[i].rgb * d;
+        if (d > 0.0) c += uSpecular.rgb * uLightColor[i].w * pow(max(dot(reflect(-L, N), V), 0.0), uSpecular.w);
+    }
+    return c;
+}
+
+void main() {
+    // Көзден (view space бас нүктесі) шыққан сәуле мен сфераның алғашқы қиылысуы
+    vec3 dir = normalize(vQuadView);
+    float b = dot(dir, vCenterView);
+    float disc = b * b - (dot(vCenterView, vCenterView) - vRadius * vRadius);
+    if (disc < 0.0) discard;
+    float t = b - sqrt(disc);
+    vec3 hit = dir * t;
+
+    vec4 clip = uProj * vec4(hit, 1.0);
+    gl_FragDepth = clip.z / clip.w * 0.5 + 0.5;
+
+    // Нормаль мен көзге бағыт әлем кеңістігіне (uView — тек айналу + жылжу)
+    mat3 toWorld = transpose(mat3(uView));
+    vec3 N = normalize(toWorld * (hit - vCenterView));
+    vec3 V = normalize(toWorld * (-hit));
+    FragColor = vec4(shade(vColor, N, V), 1.0);
+}
@@ -0,0 +1,45 @@
+#version 330 core
+layout (location = 0) in vec2 aCorner;      // квад бұрышы: [-1, 1]²
+layout (location = 1) in uint iSlot;        // инстанс: көрінетін slot | күй << 30
+
+layout (std140) uniform Frame {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uEye;
+    vec4 uLightDir[2];
+    vec4 uLightColor[2];                    // rgb — диффуз, w — specular күші
+    vec4 uAmbient;
+};
+layout (std140) uniform Materials {
+    vec4 uStateDiffuse[4];                  // NodeState бойынша
+    vec4 uSpecular;                         // rgb, w — shininess
+};
+
+uniform samplerBuffer uPosRadius;
+uniform samplerBuffer uColors;
+uniform bool uStateColored;                 // түс күйден (iSlot жоғарғы биттері), әйтпесе uColors
+
+out vec3 vQuadView;     // квад нүктесі (view space) — сәуле бағыты
+flat out vec3 vCenterView;
+flat out float vRadius;
+flat out vec3 vColor;
+
+void main() {
+    int slot = int(iSlot & 0x3FFFFFFFu);
+    vec4 pr = texelFetch(uPosRadius, slot);
+    vec3 c = (uView * vec4(pr.xyz, 1.0)).xyz;
+    float r = pr.w;
+    // Квад көз→орталық сәулесіне перпендикуляр: жанама конус бұл жазықтықты
+    // r·k радиусты шеңбер бойымен қияды, k = d / sqrt(d² − r²) — экран шетінде де
+    float d = length(c);
+    float k = d / sqrt(max(d * d - r * r, 1e-6));
+    vec3 w = c / max(d, 1e-6);
+    vec3 u = normalize(cross(w, abs(w.y) > 0.99 ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 1.0, 0.0)));
+    vec3 v = cross(u, w);
+    vec3 q = c + (aCorner.x * u + aCorner.y * v) * (r * k * 1.02);
+    vQuadView   = q;
+    vCenterView = c;
+    vRadius     = r;
+    vColor      = uStateColored ? uStateDiffuse[iSlot >> 30u].rgb : texelFetch(uColors, slot).rgb;
+    gl_Position = uProj * vec4(q, 1.0);
+}
@@ -0,0 +1,19 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;
+
+layout (std140) uniform Frame {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uEye;
+    vec4 uLightDir[2];
+    vec4 uLightColor[2];
+    vec4 uAmbient;
+};
+
+out vec4 vColor;
+
+void main() {
+    vColor = aColor;
+    gl_Position = uProj * uView * vec4(aPos, 1.0);
+}
@@ -0,0 +1,26 @@
+#version 330 core
+// Шағын инстанс тізімдері: жарқылдар (жарықсыз, additive) және proxy сфералар (жарықпен)
+layout (location = 0) in vec3 aPos;         // бірлік сфера (LOD торларының бірі)
+layout (location = 1) in vec4 iPosRadius;   // орны + радиусы
+layout (location = 2) in vec4 iColor;       // RGBA (жарқылда альфа — қосылу күші)
+
+layout (std140) uniform Frame {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uEye;
+    vec4 uLightDir[2];
+    vec4 uLightColor[2];                    // rgb — диффуз, w — specular күші
+    vec4 uAmbient;
+};
+
+out vec3 vNormal;
+out vec3 vWorld;
+out vec4 vColor;
+
+void main() {
+    vec3 world = iPosRadius.xyz + aPos * iPosRadius.w;
+    vNormal = aPos;
+    vWorld  = world;
+    vColor  = iColor;
+    gl_Position = uProj * uView * vec4(world, 1.0);
+}
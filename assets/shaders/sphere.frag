@@ -0,0 +1,35 @@
+#version 330 core
+in vec3 vNormal;
+in vec3 vWorld;
+in vec3 vColor;
+
+layout (std140) uniform Frame {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uEye;
+    vec4 uLightDir[2];
+    vec4 uLightColor[2];                    // rgb — диффуз, w — specular күші
+    vec4 uAmbient;
+};
+layout (std140) uniform Materials {
+    vec4 uStateDiffuse[4];                  // NodeState бойынша
+    vec4 uSpecular;                         // rgb, w — shininess
+};
+
+out vec4 FragColor;
+
+// beginLighting()-тегі екі бағытталған жарық (key + fill), әлем кеңістігінде
+vec3 shade(vec3 base, vec3 N, vec3 V) {
+    vec3 c = base * uAmbient.rgb;
+    for (int i = 0; i < 2; ++i) {
+        vec3 L = uLightDir[i].xyz;
+        float d = max(dot(N, L), 0.0);
+        c += base * uLightColor[i].rgb * d;
+        if (d > 0.0) c += uSpecular.rgb * uLightColor[i].w * pow(max(dot(reflect(-L, N), V), 0.0), uSpecular.w);
+    }
+    return c;
+}
+
+void main() {
+    FragColor = vec4(shade(vColor, normalize(vNormal), normalize(uEye.xyz - vWorld)), 1.0);
+}
@@ -0,0 +1,34 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;         // бірлік сфера (нормаль да осы)
+layout (location = 1) in uint iSlot;        // инстанс: көрінетін slot | күй << 30 (culling тізімінен)
+
+layout (std140) uniform Frame {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uEye;
+    vec4 uLightDir[2];
+    vec4 uLightColor[2];                    // rgb — диффуз, w — specular күші
+    vec4 uAmbient;
+};
+layout (std140) uniform Materials {
+    vec4 uStateDiffuse[4];                  // NodeState бойынша
+    vec4 uSpecular;                         // rgb, w — shininess
+};
+
+uniform samplerBuffer uPosRadius;           // slot → орны + радиусы (қабырғалармен ортақ буфер)
+uniform samplerBuffer uColors;              // slot → RGBA8 normalized
+uniform bool uStateColored;                 // түс күйден (iSlot жоғарғы биттері), әйтпесе uColors
+
+out vec3 vNormal;
+out vec3 vWorld;
+out vec3 vColor;
+
+void main() {
+    int slot = int(iSlot & 0x3FFFFFFFu);
+    vec4 pr = texelFetch(uPosRadius, slot);
+    vec3 world = pr.xyz + aPos * pr.w;
+    vNormal = aPos;
+    vWorld  = world;
+    vColor  = uStateColored ? uStateDiffuse[iSlot >> 30u].rgb : texelFetch(uColors, slot).rgb;
+    gl_Position = uProj * uView * vec4(world, 1.0);
+}
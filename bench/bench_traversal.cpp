@@ -0,0 +1,64 @@
+// Синтетикалық DAG (әдепкі: 1M төбе, 10M қабырға) бойынша BFS өлшемі.
+// Салыстыру: қарапайым бір ағынды кезек BFS ↔ TraversalEngine (1 ағын / барлық ағын).
+//   bench_traversal [nodes] [edges] [runs]
+#include "core/traversal.h"
+#include "utils/parallel.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static void naiveBfs(const Csr& c, int src, std::vector<int>& out) {
+    std::vector<char> seen(c.n(), 0);
+    out.assign(1, src);
+    seen[src] = 1;
+    for (size_t i = 0; i < out.size(); ++i)
+        for (int k = c.offs[out[i]]; k < c.offs[out[i] + 1]; ++k)
+            if (!seen[c.adj[k]]) { seen[c.adj[k]] = 1; out.push_back(c.adj[k]); }
+}
+
+template <class F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    const int  n    = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const long m    = argc > 2 ? std::atol(argv[2]) : 10000000;
+    const int  runs = argc > 3 ? std::atoi(argv[3]) : 5;
+
+    // u < v — DAG; ұзындығы әртүрлі қабырғалар (жергілікті + алыс)
+    std::mt19937 rng(42);
+    CowVector<Edge> E;
+    while ((long)E.size() < m) {
+        int u = (int)(rng() % (unsigned)(n - 1));
+        int span = (rng() & 1) ? 64 : (n - u - 1);
+        int v = u + 1 + (int)(rng() % (unsigned)std::min(span, n - u - 1));
+        E.push_back(Edge{ u, v });
+    }
+    std::printf("DAG: %d nodes, %ld edges, %d threads\n", n, m, workerCount());
+
+    Csr fwd, bwd;
+    buildCsr(E, n, fwd, bwd);           // қозғалтқыштың өз CSR құрастырушысы
+    TraversalEngine eng;
+    eng.assign(fwd, std::move(bwd));    // fwd көшірмесі naive BFS-ке қалады
+
+    std::vector<int> out;
+    for (int r = 0; r < runs; ++r) {
+        int src = (int)(rng() % (unsigned)(n / 100));       // ерте түйін — ұрпақтары көп
+        double tNaive = timeMs([&] { naiveBfs(fwd, src, out); });
+        size_t reached = out.size();
+        eng.parallel = false;
+        double tSerial = timeMs([&] { eng.bfs({ src }, TraversalEngine::Dir::Down, -1, out); });
+        eng.parallel = true;
+        double tPar = timeMs([&] { eng.bfs({ src }, TraversalEngine::Dir::Down, -1, out); });
+        const auto& st = eng.stats();
+        std::printf("src %7d  reached %8zu%s  naive %7.1f ms  engine/1 %7.1f ms  engine/%d %7.1f ms"
+                    "  (levels %d, top-down %d, bottom-up %d)\n",
+                    src, reached, reached == out.size() ? "" : " MISMATCH", tNaive, tSerial,
+                    workerCount(), tPar, st.levels, st.topDown, st.bottomUp);
+    }
+}
@@ -1,5 +1,10 @@
 #include "app.h"
 #include <iostream>
+#include <algorithm>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <unordered_map>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
@@ -8,6 +13,8 @@
 #include "vendor/imgui/backends/imgui_impl_opengl3.h"
 
 #include "core/graph.h"
+#include "core/centrality.h"
+#include "core/communities.h"
 #include "renderer/graph_renderer.h"
 #include "modules/control/message_bus.h"
 #include "modules/control/controller_panel.h"
@@ -28,8 +35,136 @@ static double gLastX = 0.0, gLastY = 0.0;
 static bool gShowEdges  = true;
 static bool gShowBounds = true;
 static bool gShowLabels = true;
+static bool gShowCritical = true;
+static bool gInstanced = true;
+static bool gCull = true;
+static bool gImpostors = false;
+static bool gMultiDraw = true;
+static int  gShards = 1;
+static bool gColorShards = false;
+static bool gClusters   = false;
+static bool gShowImpact = true;
+
+static int  gHoveredGroup = -1;
+static bool gClicked      = false;
+
+// Ховер әсері: төмен (бөгелгендер) / жоғары (тәуелділіктер), slot-тар
+static std::vector<int> gImpactDown, gImpactUp;
+static int                gImpactFor = -1;
+static unsigned long long gImpactVer = 0;
 
 static int  gHoveredId  = -1;
+static int  gSelectedId = -1;      // басылған тапсырма (қайта басу — таңдауды алу)
+
+// Таңдаудың k-қадам маңы (бағытсыз, traversal.h BFS), 0 — өшірулі
+static int  gNeighHops = 0;
+static std::vector<int> gNeigh;
+static int                gNeighFor = -1, gNeighHopsFor = 0;
+static unsigned long long gNeighVer = 0;
+
+// Кадр профайлері: update + рендер өтулері (HUD-та)
+static FrameProfiler gProf;
+static GpuTimer gGpuTimer;              // өту сайын GPU уақыты (HUD)
+static StartupTimeline gStartup;        // статикалық инициализациядан бастап
+
+// Атрибуттар бойынша іздеу (name/owner/queue ішінде), нәтиже — slot-тар
+static char gSearch[64] = "";
+static std::vector<int> gSearchHits;
+static unsigned long long gSearchVer = ~0ull;
+static std::string gSearchFor;
+
+// Құрылымдық маңыздылық: 0 — жоқ, 1 — PageRank, 2 — betweenness, 3 — тәуелділер саны
+static int  gImportanceMode = 0;
+static bool gImpScale = true, gImpColor = false;
+static std::vector<float> gImportance;                 // slot → [0,1]
+static std::shared_ptr<const CentralityResult> gImpFrom;
+static unsigned long long gImpTopo = ~0ull;
+static int gImpModeFor = -1;
+
+// Қауымдастықтар: фонда Louvain, нәтижелер арасында жаңа тапсырмалар
+// көршілерінің көпшілік қауымдастығына уақытша қосылады
+static bool gCommColor = false, gCommLayout = false;
+static std::vector<int> gCommOfSlot, gCommKeyOfSlot;   // slot → қауымдастық / кілт
+static std::shared_ptr<const CommunityResult> gCommFrom;
+static unsigned long long gCommTopo = ~0ull;
+
+static void updateCommunities(Graph& graph, const std::shared_ptr<const CommunityResult>& res,
+                              CommunityLayout& layout) {
+    if (!res) return;
+    if (res == gCommFrom && graph.topologyVersion() == gCommTopo) return;
+    gCommFrom = res;
+    gCommTopo = graph.topologyVersion();
+
+    std::unordered_map<int, int> byId;
+    byId.reserve(res->ids.size());
+    for (size_t s = 0; s < res->ids.size(); ++s) byId.emplace(res->ids[s], res->comm[s]);
+
+    const int n = graph.count();
+    const auto& E = graph.getEdges();
+    gCommOfSlot.assign(n, -1);
+    for (int s = 0; s < n; ++s) {
+        auto it = byId.find(graph.getNodes()[s].id);
+        if (it != byId.end()) gCommOfSlot[s] = it->second;
+    }
+    for (int s = 0; s < n; ++s) {
+        if (gCommOfSlot[s] >= 0) continue;
+        std::unordered_map<int, int> votes;
+        int best = -1;
+        auto vote = [&](int t) { int c = gCommOfSlot[t]; if (c >= 0 && ++votes[c] > (best >= 0 ? votes[best] : 0)) best = c; };
+        for (int e : graph.outEdgesOf(s)) vote(E[e].to);
+        for (int e : graph.inEdgesOf(s))  vote(E[e].from);
+        gCommOfSlot[s] = best;
+    }
+    gCommKeyOfSlot.assign(n, -1);
+    for (int s = 0; s < n; ++s) if (gCommOfSlot[s] >= 0) gCommKeyOfSlot[s] = res->key[gCommOfSlot[s]];
+
+    if (gCommLayout) layout.apply(graph, gCommOfSlot, res->key);
+}
+
+// Фондық нәтижені (id бойынша) ағымдағы slot-тарға салып, логарифмдік [0,1]-ге келтіреміз
+static void updateImportance(const Graph& graph, const std::shared_ptr<const CentralityResult>& res) {
+    if (!res) return;
+    if (res == gImpFrom && graph.topologyVersion() == gImpTopo && gImportanceMode == gImpModeFor) return;
+    gImpFrom = res;
+    gImpTopo = graph.topologyVersion();
+    gImpModeFor = gImportanceMode;
+
+    const int rn = (int)res->ids.size();
+    std::vector<float> val(rn);
+    float top = 0.0f;
+    for (int s = 0; s < rn; ++s) {
+        float v = (gImportanceMode == 1) ? std::log1p(res->pagerank[s] * rn)
+                : (gImportanceMode == 2) ? std::log1p(res->betweenness[s])
+                :                          std::log1p((float)res->inDeg[s]);
+        val[s] = v;
+        top = std::max(top, v);
+    }
+    std::unordered_map<int, float> byId;
+    byId.reserve(rn);
+    for (int s = 0; s < rn; ++s) byId.emplace(res->ids[s], top > 0.0f ? val[s] / top : 0.0f);
+
+    gImportance.assign(graph.count(), 0.0f);
+    for (int s = 0; s < graph.count(); ++s) {
+        auto it = byId.find(graph.getNodes()[s].id);
+        if (it != byId.end()) gImportance[s] = it->second;
+    }
+}
+
+static void updateSearch(const Graph& graph) {
+    if (gSearchFor == gSearch && gSearchVer == graph.version()) return;
+    gSearchFor = gSearch;
+    gSearchVer = graph.version();
+    gSearchHits.clear();
+    if (gSearchFor.empty()) return;
+    const auto& A = graph.attributes();
+    std::vector<int> hits;
+    for (int c : { Graph::kAttrName, Graph::kAttrOwner, Graph::kAttrQueue }) {
+        A.findContains(c, gSearchFor, hits);
+        gSearchHits.insert(gSearchHits.end(), hits.begin(), hits.end());
+    }
+    std::sort(gSearchHits.begin(), gSearchHits.end());
+    gSearchHits.erase(std::unique(gSearchHits.begin(), gSearchHits.end()), gSearchHits.end());
+}
 
 // ---- Ray-sphere intersect (return t or +inf) ----
 static float raySphereT(const Ray3D& r, const glm::vec3& c, float rad) {
@@ -43,15 +178,33 @@ static float raySphereT(const Ray3D& r, const glm::vec3& c, float rad) {
     return (t > 0.0f) ? t : 1e9f;
 }
 
+// ---- Cluster LOD: алыс топтар жабылады, жақындағанда ашылады ----
+static void updateClusterLod(Graph& graph, const glm::vec3& eye) {
+    auto& groups = graph.groups();
+    for (int g = 0; g < groups.size(); ++g) {
+        TaskGroup& tg = groups[g];
+        if (!gClusters || tg.pinned) { tg.collapsed = false; continue; }
+        float lim = (tg.level == 0) ? 4.0f : 2.5f;
+        float d = glm::length(eye - groups.centroid(g));
+        // Гистерезис: ашылу/жабылу шегі әртүрлі
+        tg.collapsed = tg.collapsed ? (d > lim) : (d > lim * 1.15f);
+    }
+}
+
 // --- input callbacks (3D) ---
 static void scroll_cb(GLFWwindow*, double, double yoff) {
+    if (ImGui::GetIO().WantCaptureMouse) return;    // UI терезесі айналдырылады
     float factor = (yoff > 0) ? 0.9f : 1.1f; // жақындау/алыстау
     gCam.dolly(factor);
 }
 static void mouse_button_cb(GLFWwindow* win, int button, int action, int) {
+    // UI үстіндегі басу виджетке тиесілі: камера да, proxy/таңдау да қозғалмайды.
+    // Жіберу (RELEASE) әрқашан өтеді — әйтпесе orbit/pan «жабысып» қалады
+    if (action == GLFW_PRESS && ImGui::GetIO().WantCaptureMouse) return;
     if (button == GLFW_MOUSE_BUTTON_LEFT) {
         if (action == GLFW_PRESS) {
             gOrbiting = true;
+            gClicked  = true;
             glfwGetCursorPos(win, &gLastX, &gLastY);
         } else if (action == GLFW_RELEASE) {
             gOrbiting = false;
@@ -93,16 +246,20 @@ void App::run() {
         std::cerr << "Failed to initialize GLFW\n";
         return;
     }
-    // OpenGL (compat for immediate-mode)
+    // OpenGL 3.3 core — рендер толығымен шейдерлі (UBO + VAO)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_COMPAT_PROFILE);
-#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
     glfwWindowHint(GLFW_DEPTH_BITS, 24);
 
     GLFWwindow* window = glfwCreateWindow(1280, 720, "EduGraph 3D", nullptr, nullptr);
+    if (!window) {
+        // Core жоқ драйвер: compat контекст, шейдер болмаса — ескі fixed-function жол
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_COMPAT_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_FALSE);
+        window = glfwCreateWindow(1280, 720, "EduGraph 3D", nullptr, nullptr);
+    }
     if (!window) {
         std::cerr << "Failed to create GLFW window\n";
         glfwTerminate();
@@ -116,6 +273,7 @@ void App::run() {
         std::cerr << "Failed to initialize GLAD\n";
         return;
     }
+    gStartup.mark("window + GL context");
 
     // Callbacks
     glfwSetScrollCallback(gWindow,        scroll_cb);
@@ -129,13 +287,20 @@ void App::run() {
     ImGui::StyleColorsDark();
     ImGui_ImplGlfw_InitForOpenGL(gWindow, true);
     ImGui_ImplOpenGL3_Init("#version 330");
+    gStartup.mark("imgui");
 
     // --- App state ---
     Graph graph(20);
     MessageBus bus(graph);
     GraphRenderer renderer;
+    CentralityWorker centrality;
+    CommunityWorker  communities;
+    CommunityLayout  commLayout;
     ControllerPanel controller{bus};
     WorkerPanel worker{bus};
+    renderer.shaderManager().setTimeline(&gStartup);   // бірінші кадрдағы шейдерлер
+    gStartup.mark("app state");
+    bool firstFrame = true;
 
     // Камера бастапқы мәндері
     gCam.target   = glm::vec3(0.0f, 0.0f, 0.0f);
@@ -162,11 +327,44 @@ void App::run() {
             glfwGetFramebufferSize(gWindow, &W, &H);    // ✅ window -> gWindow
             Ray3D ray = gCam.rayFromScreen(mx, my, W, H);
             gHoveredId = -1;
+            gHoveredGroup = -1;
             float bestT = 1e9f;
-            for (const auto& n : graph.getNodes()) {
+            const auto& groups = graph.groups();
+            for (int i = 0; i < graph.count(); ++i) {
+                if (groups.hidden(i)) continue;
+                const auto& n = graph.getNodes()[i];
                 float t = raySphereT(ray, n.pos, 0.08f);
                 if (t < bestT) { bestT = t; gHoveredId = n.id; }
             }
+            for (int g = 0; g < groups.size(); ++g) {
+                if (!groups.isProxy(g)) continue;
+                float t = raySphereT(ray, groups.centroid(g), GraphRenderer::proxyRadius(groups[g]));
+                if (t < bestT) { bestT = t; gHoveredGroup = g; gHoveredId = -1; }
+            }
+
+            // Proxy-ді басу — топты ашық ұстау; тапсырманы басу — таңдау
+            if (gClicked && gHoveredGroup >= 0) graph.groups()[gHoveredGroup].pinned = true;
+            if (gClicked && gHoveredId >= 0) gSelectedId = (gSelectedId == gHoveredId) ? -1 : gHoveredId;
+            gClicked = false;
+        }
+        updateClusterLod(graph, gCam.getEye());
+
+        // Әсер ету подграфы тек ховер не құрылым өзгергенде қайта есептеледі
+        if (gHoveredId != gImpactFor || graph.topologyVersion() != gImpactVer) {
+            gImpactFor = gHoveredId;
+            gImpactVer = graph.topologyVersion();
+            graph.downstreamOf(gHoveredId, gImpactDown);
+            graph.upstreamOf(gHoveredId, gImpactUp);
+        }
+        if (gSelectedId < 0 || gNeighHops == 0) {
+            gNeigh.clear();
+            gNeighFor = -1;
+        } else if (gSelectedId != gNeighFor || gNeighHops != gNeighHopsFor ||
+                   graph.topologyVersion() != gNeighVer) {
+            gNeighFor = gSelectedId;
+            gNeighHopsFor = gNeighHops;
+            gNeighVer = graph.topologyVersion();
+            graph.neighbourhood(gSelectedId, gNeighHops, gNeigh);
         }
 
         // --- ImGui frame ---
@@ -181,17 +379,68 @@ void App::run() {
         ImGui::Checkbox("Show edges",  &gShowEdges);
         ImGui::Checkbox("Show bounds", &gShowBounds);
         ImGui::Checkbox("Show labels", &gShowLabels);
+        ImGui::Checkbox("Show critical path", &gShowCritical);
+        if (!renderer.coreProfile()) ImGui::Checkbox("GPU instancing", &gInstanced);   // core-да ескі жол жоқ
+        ImGui::Checkbox("Frustum culling", &gCull);
+        if (gInstanced || renderer.coreProfile()) ImGui::Checkbox("Sphere impostors", &gImpostors);
+        if ((gInstanced || renderer.coreProfile()) && !gImpostors && renderer.multiDrawSupported())
+            ImGui::Checkbox("Multi-draw indirect", &gMultiDraw);
+        ImGui::Checkbox("Hover impact", &gShowImpact);
+        ImGui::SliderInt("Selection hops", &gNeighHops, 0, 6);
+        ImGui::Checkbox("Group clusters", &gClusters);
+        if (ImGui::SliderInt("Shards", &gShards, 1, 8)) graph.setShardCount(gShards);
+        if (gShards > 1) ImGui::Checkbox("Color by shard", &gColorShards);
+        bool commOn = gCommColor || gCommLayout;
+        ImGui::Checkbox("Community colors", &gCommColor);
+        ImGui::SameLine();
+        if (ImGui::Checkbox("Community layout", &gCommLayout)) gCommTopo = ~0ull;   // бірден қолдану
+        if (commOn) {
+            if (auto res = communities.latest())
+                ImGui::Text("communities: %d, Q=%.3f, %.0f ms%s", res->count, res->modularity, res->ms,
+                            communities.busy() ? " (updating)" : "");
+        }
+        ImGui::Combo("Importance", &gImportanceMode, "Off\0PageRank\0Betweenness\0Dependents\0");
+        if (gImportanceMode > 0) {
+            ImGui::Checkbox("Scale", &gImpScale);
+            ImGui::SameLine();
+            ImGui::Checkbox("Color", &gImpColor);
+            if (auto res = centrality.latest())
+                ImGui::Text("centrality: %.0f ms, PR %d iters, BC %d src%s", res->ms, res->prIters, res->btSamples,
+                            centrality.busy() ? " (updating)" : "");
+        }
+        if (gClusters) {
+            ImGui::SameLine();
+            if (ImGui::Button("Collapse all")) {
+                for (int g = 0; g < graph.groups().size(); ++g) graph.groups()[g].pinned = false;
+            }
+        }
         ImGui::End();
 
         ImGui::Begin("Worker");
         worker.draw();
         ImGui::End();
 
+        ImGui::Begin("Search");
+        ImGui::InputText("name / owner / queue", gSearch, sizeof(gSearch));
+        updateSearch(graph);
+        ImGui::Text("Matches: %d", (int)gSearchHits.size());
+        for (size_t i = 0; i < gSearchHits.size() && i < 12; ++i) {
+            std::string_view nm = graph.nameOf(gSearchHits[i]);
+            ImGui::Text("#%d  %.*s", graph.getNodes()[gSearchHits[i]].id, (int)nm.size(), nm.data());
+        }
+        ImGui::End();
+
+        if (gHoveredId >= 0 && !ImGui::GetIO().WantCaptureMouse) drawInspector(graph, gHoveredId);
+
         // Legend / Stats HUD
-        drawLegendAndStats(graph);
+        drawLegendAndStats(graph, &gProf, &renderer, &gGpuTimer);
+        drawShaderPanel(renderer.shaderManager(), gStartup);
 
         // --- Update world ---
-        graph.update(dt);
+        {
+            FrameProfiler::Scope t(&gProf, "update");
+            graph.update(dt);
+        }
 
         // --- Clear & render ---
         int display_w, display_h;
@@ -200,22 +449,61 @@ void App::run() {
         glEnable(GL_DEPTH_TEST);
         glClearColor(0.07f, 0.08f, 0.10f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        gGpuTimer.beginFrame();
 
         RenderOptions ro;
         ro.showEdges  = gShowEdges;
         ro.showBounds = gShowBounds;
         ro.haloHover  = true;
+        ro.showCritical = gShowCritical;
+        ro.instanced    = gInstanced;
+        ro.cull         = gCull;
+        ro.impostors    = gImpostors;
+        ro.multiDraw    = gMultiDraw;
+        ro.colorByShard = gColorShards && gShards > 1;
+        if (gCommColor || gCommLayout) {
+            communities.request(graph);
+            updateCommunities(graph, communities.latest(), commLayout);
+            if (gCommColor && (int)gCommKeyOfSlot.size() == graph.count()) ro.communityKey = &gCommKeyOfSlot;
+        }
+        if (gImportanceMode > 0) {
+            centrality.request(graph);
+            updateImportance(graph, centrality.latest());
+            if ((int)gImportance.size() == graph.count()) {
+                ro.importance      = &gImportance;
+                ro.importanceScale = gImpScale;
+                ro.importanceColor = gImpColor;
+            }
+        }
+        ro.hoveredGroup = gHoveredGroup;
+        ro.selectedId   = gSelectedId;
+        if (!gSearchHits.empty()) ro.searchHits = &gSearchHits;
+        if (!gNeigh.empty()) ro.neighbourhood = &gNeigh;
+        ro.profiler     = &gProf;
+        ro.gpuTimer     = &gGpuTimer;
+        if (gShowImpact) {
+            ro.impactDown = &gImpactDown;
+            ro.impactUp   = &gImpactUp;
+        }
 
         renderer.render(graph, gCam, display_w, display_h, gHoveredId, ro);
 
         // Labels on top
-        if (gShowLabels) drawLabelsOverlay(graph, gCam, display_w, display_h, gHoveredId);
+        if (gShowLabels) drawLabelsOverlay(graph, gCam, display_w, display_h, gHoveredId, &renderer.culling());
 
         // ImGui draw
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            GpuTimer::Scope t(&gGpuTimer, "imgui");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
 
         glfwSwapBuffers(gWindow); // ✅
+        if (firstFrame) {
+            firstFrame = false;
+            gStartup.mark("first frame");
+            renderer.shaderManager().setTimeline(nullptr);   // кейінгі reload-тар — timeline-да емес
+        }
     }
 
     // --- Shutdown ---
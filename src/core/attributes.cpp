@@ -0,0 +1,243 @@
+#include "attributes.h"
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+
+uint32_t StringPool::intern(std::string_view s) {
+    auto it = index.find(s);
+    if (it != index.end()) return it->second;
+
+    const char* p = "";
+    if (!s.empty()) {
+        if (used + s.size() > kBlock) {
+            blocks.emplace_back(new char[std::max(kBlock, s.size())]);
+            used = 0;
+        }
+        char* dst = blocks.back().get() + used;
+        std::memcpy(dst, s.data(), s.size());
+        used += s.size();
+        p = dst;
+    }
+    uint32_t code = (uint32_t)strs.size();
+    strs.emplace_back(p, s.size());
+    index.emplace(strs.back(), code);
+    return code;
+}
+
+int64_t StringPool::find(std::string_view s) const {
+    auto it = index.find(s);
+    return (it == index.end()) ? -1 : (int64_t)it->second;
+}
+
+size_t StringPool::bytesUsed() const {
+    return blocks.size() * kBlock + strs.capacity() * sizeof(std::string_view)
+         + index.size() * (sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*));
+}
+
+// ----------------------------------------------------------------------------
+
+int AttributeStore::addColumn(std::string_view name, Type t) {
+    int c = column(name);
+    if (c >= 0) return c;
+    Column col;
+    col.name = std::string(name);
+    col.type = t;
+    col.width = (t == Type::Str) ? 1 : (t == Type::Text) ? 0 : 4;
+    col.data.assign((size_t)n * col.width, 0);
+    if (t == Type::Str) { col.dict.push_back(0); col.dictIndex[0] = 0; }
+    if (t == Type::Text) { col.off.assign(n, 0); col.len.assign(n, 0); }
+    cols.push_back(std::move(col));
+    return (int)cols.size() - 1;
+}
+
+int AttributeStore::column(std::string_view name) const {
+    for (int c = 0; c < (int)cols.size(); ++c) if (cols[c].name == name) return c;
+    return -1;
+}
+
+uint32_t AttributeStore::load(const Column& col, int slot) {
+    const uint8_t* p = &col.data[(size_t)slot * col.width];
+    switch (col.width) {
+        case 1: return p[0];
+        case 2: { uint16_t v; std::memcpy(&v, p, 2); return v; }
+        default: { uint32_t v; std::memcpy(&v, p, 4); return v; }
+    }
+}
+
+void AttributeStore::store(Column& col, int slot, uint32_t v) {
+    uint8_t* p = &col.data[(size_t)slot * col.width];
+    switch (col.width) {
+        case 1: p[0] = (uint8_t)v; break;
+        case 2: { uint16_t x = (uint16_t)v; std::memcpy(p, &x, 2); break; }
+        default: std::memcpy(p, &v, 4); break;
+    }
+}
+
+// Кодтар енді сыймаса бағананы кеңірек енмен қайта жазамыз (сирек, O(n))
+void AttributeStore::widen(Column& col, uint8_t w) {
+    Column tmp;
+    tmp.width = w;
+    tmp.data.assign(col.data.size() / col.width * w, 0);
+    const int rows = (int)(col.data.size() / col.width);
+    for (int s = 0; s < rows; ++s) store(tmp, s, load(col, s));
+    col.data.swap(tmp.data);
+    col.width = w;
+}
+
+// Тірі мәндерді slot ретімен жаңа буферге көшіру — O(тірі байттар)
+void AttributeStore::compactText(Column& col) {
+    std::vector<char> packed;
+    packed.reserve(col.text.size() - col.dead);
+    for (size_t s = 0; s < col.off.size(); ++s) {
+        const char* p = col.text.data() + col.off[s];
+        col.off[s] = (uint32_t)packed.size();
+        packed.insert(packed.end(), p, p + col.len[s]);
+    }
+    col.text.swap(packed);
+    col.dead = 0;
+}
+
+void AttributeStore::onNodeAdded(int slot) {
+    n = slot + 1;
+    for (auto& col : cols) {
+        col.data.resize((size_t)n * col.width, 0);
+        if (col.type == Type::Text) { col.off.resize(n, 0); col.len.resize(n, 0); }
+    }
+}
+
+void AttributeStore::onNodeRemoved(int slot, int last) {
+    for (auto& col : cols) {
+        if (col.type == Type::Text) {
+            col.dead += col.len[slot];
+            col.off[slot] = col.off[last];
+            col.len[slot] = col.len[last];
+            col.off.pop_back();
+            col.len.pop_back();
+            if (col.dead > 4096 && col.dead * 2 > col.text.size()) compactText(col);
+            continue;
+        }
+        if (slot != last)
+            std::memcpy(&col.data[(size_t)slot * col.width], &col.data[(size_t)last * col.width], col.width);
+        col.data.resize((size_t)last * col.width);
+    }
+    n = last;
+}
+
+void AttributeStore::setInt(int c, int slot, int32_t v) {
+    uint32_t u;
+    std::memcpy(&u, &v, 4);
+    store(cols[c], slot, u);
+}
+
+int32_t AttributeStore::getInt(int c, int slot) const {
+    uint32_t u = load(cols[c], slot);
+    int32_t v;
+    std::memcpy(&v, &u, 4);
+    return v;
+}
+
+void AttributeStore::setFloat(int c, int slot, float v) {
+    uint32_t u;
+    std::memcpy(&u, &v, 4);
+    store(cols[c], slot, u);
+}
+
+float AttributeStore::getFloat(int c, int slot) const {
+    uint32_t u = load(cols[c], slot);
+    float v;
+    std::memcpy(&v, &u, 4);
+    return v;
+}
+
+void AttributeStore::setStr(int c, int slot, std::string_view s) {
+    Column& col = cols[c];
+    if (col.type == Type::Text) {
+        // s буфердің өзіне сілтесе — ықшамдау/кеңею оны бұзады, алдымен көшіреміз
+        const char* b = col.text.data();
+        if (!s.empty() && s.data() >= b && s.data() < b + col.text.size()) {
+            std::string copy(s);
+            setStr(c, slot, copy);
+            return;
+        }
+        col.dead += col.len[slot];
+        col.len[slot] = 0;
+        if (col.dead > 4096 && col.dead * 2 > col.text.size()) compactText(col);
+        col.off[slot] = (uint32_t)col.text.size();
+        col.len[slot] = (uint32_t)s.size();
+        col.text.insert(col.text.end(), s.begin(), s.end());
+        return;
+    }
+    uint32_t code = pool.intern(s);
+    auto it = col.dictIndex.find(code);
+    uint32_t local;
+    if (it != col.dictIndex.end()) {
+        local = it->second;
+    } else {
+        local = (uint32_t)col.dict.size();
+        col.dict.push_back(code);
+        col.dictIndex.emplace(code, local);
+        if (col.width == 1 && local > 0xFFu)   widen(col, 2);
+        if (col.width == 2 && local > 0xFFFFu) widen(col, 4);
+    }
+    store(col, slot, local);
+}
+
+std::string_view AttributeStore::getStr(int c, int slot) const {
+    const Column& col = cols[c];
+    if (col.type == Type::Text) return { col.text.data() + col.off[slot], col.len[slot] };
+    return pool.view(col.dict[load(col, slot)]);
+}
+
+std::string AttributeStore::format(int c, int slot) const {
+    switch (cols[c].type) {
+        case Type::Int:   return std::to_string(getInt(c, slot));
+        case Type::Float: { char b[32]; snprintf(b, sizeof(b), "%.2f", getFloat(c, slot)); return b; }
+        default:          return std::string(getStr(c, slot));
+    }
+}
+
+void AttributeStore::scanCodes(const Column& col, const std::vector<char>& match,
+                               std::vector<int>& outSlots) const {
+    outSlots.clear();
+    for (int s = 0; s < n; ++s) if (match[load(col, s)]) outSlots.push_back(s);
+}
+
+void AttributeStore::findEqual(int c, std::string_view s, std::vector<int>& outSlots) const {
+    const Column& col = cols[c];
+    outSlots.clear();
+    if (col.type == Type::Text) {
+        for (int sl = 0; sl < n; ++sl) if (getStr(c, sl) == s) outSlots.push_back(sl);
+        return;
+    }
+    int64_t code = pool.find(s);
+    if (col.type != Type::Str || code < 0) return;
+    auto it = col.dictIndex.find((uint32_t)code);
+    if (it == col.dictIndex.end()) return;
+    std::vector<char> match(col.dict.size(), 0);
+    match[it->second] = 1;
+    scanCodes(col, match, outSlots);
+}
+
+void AttributeStore::findContains(int c, std::string_view s, std::vector<int>& outSlots) const {
+    const Column& col = cols[c];
+    outSlots.clear();
+    if (col.type == Type::Text) {
+        for (int sl = 0; sl < n; ++sl)
+            if (getStr(c, sl).find(s) != std::string_view::npos) outSlots.push_back(sl);
+        return;
+    }
+    if (col.type != Type::Str) return;
+    std::vector<char> match(col.dict.size(), 0);
+    bool any = false;
+    for (size_t i = 0; i < col.dict.size(); ++i)
+        if (pool.view(col.dict[i]).find(s) != std::string_view::npos) match[i] = 1, any = true;
+    if (any) scanCodes(col, match, outSlots);
+}
+
+size_t AttributeStore::bytesUsed() const {
+    size_t b = pool.bytesUsed();
+    for (const auto& col : cols)
+        b += col.data.capacity() + col.dict.capacity() * sizeof(uint32_t)
+           + col.text.capacity() + (col.off.capacity() + col.len.capacity()) * sizeof(uint32_t);
+    return b;
+}
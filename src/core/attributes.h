@@ -0,0 +1,86 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// Жолдарды интерндеу: мәтін бір рет arena-ға жазылады, әрі қарай тек uint32 код.
+// Arena блоктары жылжымайды — string_view кілттері тұрақты.
+class StringPool {
+public:
+    StringPool() { intern({}); }                    // 0 — бос жол
+
+    uint32_t intern(std::string_view s);
+    int64_t  find(std::string_view s) const;        // жоқ болса -1
+    std::string_view view(uint32_t code) const { return strs[code]; }
+    uint32_t size() const { return (uint32_t)strs.size(); }
+    size_t   bytesUsed() const;
+
+private:
+    static constexpr size_t kBlock = 64 * 1024;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t used = kBlock;                           // ағымдағы блоктағы толу
+    std::vector<std::string_view> strs;
+    std::unordered_map<std::string_view, uint32_t> index;
+};
+
+// Бағаналы атрибут қоймасы (slot бойынша). Физика бұған тимейді —
+// тек белгілер, іздеу және инспектор оқиды. Str бағаналары сөздікпен
+// кодталады: slot-та 1/2/4 байттық жергілікті код (сөздік өскенде кеңейеді).
+// Text — қайталанбайтын мәндерге (атаулар): сөздіксіз, бағананың өз буферінде
+// slot сайын [off, off+len); жойылған байттар басым болса буфер ықшамдалады.
+class AttributeStore {
+public:
+    enum class Type : uint8_t { Int, Float, Str, Text };
+
+    int  addColumn(std::string_view name, Type t);  // бар болса — сол индекс
+    int  column(std::string_view name) const;       // жоқ болса -1
+    int  columnCount() const { return (int)cols.size(); }
+    const std::string& columnName(int c) const { return cols[c].name; }
+    Type columnType(int c) const { return cols[c].type; }
+
+    // Graph хуктары
+    void onNodeAdded(int slot);
+    void onNodeRemoved(int slot, int last);         // swap-remove алдында
+
+    void    setInt(int c, int slot, int32_t v);
+    int32_t getInt(int c, int slot) const;
+    void    setFloat(int c, int slot, float v);
+    float   getFloat(int c, int slot) const;
+    void    setStr(int c, int slot, std::string_view s);
+    std::string_view getStr(int c, int slot) const;    // Text: келесі жазу/жоюға дейін жарамды
+    std::string format(int c, int slot) const;      // инспектор үшін
+
+    // Іздеу: алдымен сөздік (аз), содан соң кодтар бағанасы бойынша бір өту
+    void findEqual(int c, std::string_view s, std::vector<int>& outSlots) const;
+    void findContains(int c, std::string_view s, std::vector<int>& outSlots) const;
+
+    size_t bytesUsed() const;
+    const StringPool& strings() const { return pool; }
+
+private:
+    struct Column {
+        std::string name;
+        Type type = Type::Int;
+        uint8_t width = 4;                          // slot-тағы байт саны
+        std::vector<uint8_t> data;                  // n * width
+        std::vector<uint32_t> dict;                 // жергілікті код → pool коды (0 → "")
+        std::unordered_map<uint32_t, uint32_t> dictIndex;
+        std::vector<char> text;                     // Text: барлық мәндер қатар
+        std::vector<uint32_t> off, len;             // Text: slot → буфердегі орны
+        size_t dead = 0;                            // Text: ешкім сілтемейтін байттар
+    };
+
+    static uint32_t load(const Column& col, int slot);
+    static void     store(Column& col, int slot, uint32_t v);
+    static void     widen(Column& col, uint8_t w);
+    static void     compactText(Column& col);
+    void scanCodes(const Column& col, const std::vector<char>& match, std::vector<int>& outSlots) const;
+
+    std::vector<Column> cols;
+    StringPool pool;
+    int n = 0;
+};
@@ -0,0 +1,187 @@
+#include "centrality.h"
+#include "graph.h"
+#include "../utils/parallel.h"
+#include <algorithm>
+#include <unordered_map>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <numeric>
+
+namespace {
+constexpr int kGrain = 1 << 15;     // бір жұмыс бөлігіндегі төбе саны
+
+int chunkCount(int n) {
+    return std::max(1, std::min(workerCount() * 4, (n + kGrain - 1) / kGrain));
+}
+
+// f(c, lo, hi) — [0, n) аралығының c-ші бөлігі
+template <class F>
+void forChunks(int n, F&& f) {
+    const int chunks = chunkCount(n);
+    parallelFor(chunks, [&](int c) {
+        f(c, (int)((long long)n * c / chunks), (int)((long long)n * (c + 1) / chunks));
+    });
+}
+} // namespace
+
+// Pull түрі: pr'[v] = (1-d)/n + d·(Σ_{u ∈ succ(v)} pr[u]/indeg(u) + сорғыштар/n)
+// (ранг тәуелді тапсырмадан оның тәуелділіктеріне ағады)
+int Centrality::pageRank(const Csr& out, const Csr& in, std::vector<float>& pr,
+                         float damping, float tol, int maxIter) {
+    const int n = out.n();
+    if (n == 0) { pr.clear(); return 0; }
+    if ((int)pr.size() != n) pr.assign(n, 1.0f / n);
+
+    std::vector<float> contrib(n), next(n);
+    int it = 0;
+    for (; it < maxIter; ++it) {
+        // Кіріс қабырғасы жоқтар (ранг бере алмайтындар) — біркелкі таратылады
+        double dangling = 0.0;
+        for (int v = 0; v < n; ++v) {
+            int d = in.degree(v);
+            contrib[v] = d ? pr[v] / d : 0.0f;
+            if (!d) dangling += pr[v];
+        }
+        const float base = (float)((1.0 - damping) / n + damping * dangling / n);
+
+        std::vector<double> errPart(chunkCount(n), 0.0);
+        forChunks(n, [&](int c, int lo, int hi) {
+            double err = 0.0;
+            for (int v = lo; v < hi; ++v) {
+                float s = 0.0f;
+                for (int k = out.offs[v]; k < out.offs[v + 1]; ++k) s += contrib[out.adj[k]];
+                next[v] = base + damping * s;
+                err += std::fabs(next[v] - pr[v]);
+            }
+            errPart[c] = err;
+        });
+        pr.swap(next);
+        double err = 0.0;
+        for (double e : errPart) err += e;
+        if (err < tol) { ++it; break; }
+    }
+    return it;
+}
+
+// Brandes (салмақсыз, бағытты) берілген көздерден; әр жұмысшы өз массивтерімен
+void Centrality::betweenness(const Csr& out, const int* src, int count, std::vector<float>& bc) {
+    const int n = out.n();
+    bc.assign(n, 0.0f);
+    if (n == 0 || count <= 0) return;
+
+    const int workers = std::max(1, std::min(workerCount(), count));
+    std::vector<std::vector<float>> partial(workers);
+    parallelFor(workers, [&](int w) {
+        std::vector<float>& acc = partial[w];
+        acc.assign(n, 0.0f);
+        std::vector<int> dist(n, -1), order;
+        std::vector<double> sigma(n, 0.0), delta(n, 0.0);
+        order.reserve(n);
+        for (int i = w; i < count; i += workers) {
+            int s = src[i];
+            order.assign(1, s);
+            dist[s] = 0;
+            sigma[s] = 1.0;
+            for (size_t q = 0; q < order.size(); ++q) {
+                int v = order[q];
+                for (int k = out.offs[v]; k < out.offs[v + 1]; ++k) {
+                    int t = out.adj[k];
+                    if (dist[t] < 0) { dist[t] = dist[v] + 1; order.push_back(t); }
+                    if (dist[t] == dist[v] + 1) sigma[t] += sigma[v];
+                }
+            }
+            for (size_t q = order.size(); q-- > 0; ) {
+                int v = order[q];
+                for (int k = out.offs[v]; k < out.offs[v + 1]; ++k) {
+                    int t = out.adj[k];
+                    if (dist[t] == dist[v] + 1) delta[v] += sigma[v] / sigma[t] * (1.0 + delta[t]);
+                }
+                if (v != s) acc[v] += (float)delta[v];
+            }
+            for (int v : order) { dist[v] = -1; sigma[v] = 0.0; delta[v] = 0.0; }
+        }
+    });
+
+    const float scale = (float)n / (float)count;
+    forChunks(n, [&](int, int lo, int hi) {
+        for (int v = lo; v < hi; ++v) {
+            float s = 0.0f;
+            for (const auto& p : partial) s += p[v];
+            bc[v] = s * scale;
+        }
+    });
+}
+
+// ----------------------------------------------------------------------------
+
+CentralityWorker::CentralityWorker()
+    : worker([this](const GraphSnapshot& s, const std::shared_ptr<const CentralityResult>& p) { return compute(s, p); }) {}
+
+std::shared_ptr<CentralityResult> CentralityWorker::compute(const GraphSnapshot& snap,
+                                                            const std::shared_ptr<const CentralityResult>& prev) {
+    auto t0 = std::chrono::steady_clock::now();
+    auto res = std::make_shared<CentralityResult>();
+    const int n = snap.count();
+    res->topoVersion = snap.topologyVersion();
+    res->ids.resize(n);
+    for (int s = 0; s < n; ++s) res->ids[s] = snap.getNodes()[s].id;
+
+    Csr out, in;
+    buildCsr(snap.getEdges(), n, out, in);
+    res->inDeg.resize(n);
+    res->outDeg.resize(n);
+    for (int v = 0; v < n; ++v) { res->inDeg[v] = in.degree(v); res->outDeg[v] = out.degree(v); }
+
+    // Топология сол — slot-тар мен қабырғалар да сол, PageRank қайта есептелмейді
+    const bool sameTopo = prev && prev->topoVersion == res->topoVersion && (int)prev->ids.size() == n;
+
+    // Алдыңғы нәтижеден id бойынша жылы старт
+    std::unordered_map<int, int> prevSlot;
+    if (prev && !sameTopo) {
+        prevSlot.reserve(prev->ids.size());
+        for (int s = 0; s < (int)prev->ids.size(); ++s) prevSlot.emplace(prev->ids[s], s);
+    }
+    if (sameTopo) {
+        res->pagerank = prev->pagerank;
+        res->prIters  = prev->prIters;
+    } else if (prev && n > 0) {
+        res->pagerank.assign(n, 1.0f / n);
+        double sum = 0.0;
+        for (int s = 0; s < n; ++s) {
+            auto it = prevSlot.find(res->ids[s]);
+            if (it != prevSlot.end()) res->pagerank[s] = prev->pagerank[it->second];
+            sum += res->pagerank[s];
+        }
+        for (float& p : res->pagerank) p = (float)(p / sum);
+    }
+    if (!sameTopo) res->prIters = Centrality::pageRank(out, in, res->pagerank);
+
+    // Betweenness: көздер топологияға бір рет араластырылған ауыстырудан кезекпен
+    // алынады — нақтылауда бұрынғы көздер қайталанбайды. Тек сол топологияның
+    // бағасымен біріктіріледі (көз саны бойынша салмақ)
+    int used = 0;
+    if (sameTopo && prev->btOrder) {
+        res->btOrder = prev->btOrder;
+        used = prev->btSamples;
+    } else {
+        auto order = std::make_shared<std::vector<int>>(n);
+        std::iota(order->begin(), order->end(), 0);
+        std::shuffle(order->begin(), order->end(), std::mt19937(seed++));
+        res->btOrder = std::move(order);
+    }
+    const int k = std::min(betweennessSamples.load(), n - used);
+    Centrality::betweenness(out, res->btOrder->data() + used, k, res->betweenness);
+    res->btSamples = k;
+    if (used > 0) {
+        const float wPrev = (float)prev->btSamples / (float)(prev->btSamples + k);
+        for (int s = 0; s < n; ++s)
+            res->betweenness[s] = wPrev * prev->betweenness[s] + (1.0f - wPrev) * res->betweenness[s];
+        res->btSamples += prev->btSamples;
+    }
+
+    for (float p : res->pagerank)    res->prMax = std::max(res->prMax, p);
+    for (float b : res->betweenness) res->btMax = std::max(res->btMax, b);
+    res->ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return res;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "traversal.h"
+#include "snapshot_worker.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+
+// Құрылымдық маңыздылық ядролары (CSR бойынша, параллель).
+// PageRank тәуелділер → тәуелділік бағытында ағады: көп жұмыс күтетін
+// тапсырманың рангі жоғары. Betweenness — k кездейсоқ көзден Brandes.
+namespace Centrality {
+    // pr — бастапқы мән (жылы старт); бос болса 1/n. Итерация саны қайтады
+    int  pageRank(const Csr& out, const Csr& in, std::vector<float>& pr,
+                  float damping = 0.85f, float tol = 1e-6f, int maxIter = 50);
+    // sources — Brandes көздері (қайталанбайтын slot-тар); барлығы болса — дәл мән
+    void betweenness(const Csr& out, const int* sources, int count, std::vector<float>& bc);
+}
+
+struct CentralityResult {
+    unsigned long long topoVersion = 0;
+    std::vector<int>   ids;                 // snapshot кезіндегі slot → id
+    std::vector<float> pagerank, betweenness;
+    std::vector<int>   inDeg, outDeg;
+    float prMax = 0.0f, btMax = 0.0f;
+    int   prIters = 0;
+    int   btSamples = 0;                    // betweenness бағасындағы жалпы көз саны
+    std::shared_ptr<const std::vector<int>> btOrder;   // топологияның көз ауыстыруы, алғашқы btSamples қолданылды
+    double ms = 0.0;
+};
+
+// Фондық ағын (SnapshotWorker): PageRank алдыңғы нәтижеден (id бойынша) жылы басталады,
+// топология өзгермесе — сол күйі алынады. Betweenness — іріктемелі баға: топология
+// өзгерсе жаңа ауыстыру мен нөлден, өзгермесе сол ауыстырудың келесі көздері
+// бұрынғыларға көз саны бойынша салмақпен қосылады (maxBetweennessSamples-ке дейін).
+class CentralityWorker {
+public:
+    CentralityWorker();
+
+    void request(const Graph& g) {
+        // Топология тұрақты болса — сол топологияның бағасын нақтылау
+        auto last = worker.latest();
+        const bool refine = last && last->topoVersion == g.topologyVersion()
+                         && last->btSamples < std::min(g.count(), maxBetweennessSamples.load());
+        worker.request(g, refine);
+    }
+    std::shared_ptr<const CentralityResult> latest() const { return worker.latest(); }
+    bool busy() const { return worker.busy(); }
+
+    std::atomic<int> betweennessSamples{ 16 };      // бір есептегі көз саны
+    std::atomic<int> maxBetweennessSamples{ 256 };
+
+private:
+    std::shared_ptr<CentralityResult> compute(const GraphSnapshot& snap,
+                                              const std::shared_ptr<const CentralityResult>& prev);
+
+    std::atomic<unsigned> seed{ 1 };
+    SnapshotWorker<CentralityResult> worker;
+};
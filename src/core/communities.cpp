@@ -0,0 +1,283 @@
+#include "communities.h"
+#include "../utils/parallel.h"
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <climits>
+#include <unordered_set>
+
+namespace {
+
+// Бағытсыз салмақты граф; self — ішкі салмақ (әр қабырға екі рет)
+struct WGraph {
+    std::vector<int> xadj, adj;
+    std::vector<float> w;
+    std::vector<double> self, k;
+    double m2 = 0.0;
+    int n() const { return (int)k.size(); }
+};
+
+WGraph fromCsr(const Csr& out, const Csr& in) {
+    const int n = out.n();
+    WGraph G;
+    G.xadj.assign(n + 1, 0);
+    for (int v = 0; v < n; ++v) G.xadj[v + 1] = G.xadj[v] + out.degree(v) + in.degree(v);
+    G.adj.resize(G.xadj[n]);
+    G.w.assign(G.xadj[n], 1.0f);
+    G.self.assign(n, 0.0);
+    G.k.resize(n);
+    for (int v = 0; v < n; ++v) {
+        int p = G.xadj[v];
+        for (int j = out.offs[v]; j < out.offs[v + 1]; ++j) G.adj[p++] = out.adj[j];
+        for (int j = in.offs[v];  j < in.offs[v + 1];  ++j) G.adj[p++] = in.adj[j];
+        G.k[v] = G.xadj[v + 1] - G.xadj[v];
+    }
+    G.m2 = (double)G.adj.size();
+    return G;
+}
+
+double modularity(const WGraph& G, const std::vector<int>& comm, int nc) {
+    std::vector<double> in(nc, 0.0), tot(nc, 0.0);
+    for (int v = 0; v < G.n(); ++v) {
+        int c = comm[v];
+        tot[c] += G.k[v];
+        in[c]  += G.self[v];
+        for (int e = G.xadj[v]; e < G.xadj[v + 1]; ++e)
+            if (comm[G.adj[e]] == c) in[c] += G.w[e];
+    }
+    double q = 0.0;
+    for (int c = 0; c < nc; ++c) q += in[c] / G.m2 - (tot[c] / G.m2) * (tot[c] / G.m2);
+    return q;
+}
+
+// Белгілерді 0..k-1 етіп қайта нөмірлеу; k қайтады.
+// Белгілер n-нен үлкен болуы мүмкін (жылы старт) — map ең үлкен белгіге дейін
+int compact(std::vector<int>& comm) {
+    if (comm.empty()) return 0;
+    std::vector<int> map(*std::max_element(comm.begin(), comm.end()) + 1, -1);
+    int k = 0;
+    for (int& c : comm) {
+        if (map[c] < 0) map[c] = k++;
+        c = map[c];
+    }
+    return k;
+}
+
+// Синхронды параллель жергілікті жылжу; ең жақсы модулярлықтағы бөлу қалады
+double localMoving(const WGraph& G, std::vector<int>& comm) {
+    const int n = G.n();
+    int nc = compact(comm);
+    std::vector<double> tot(n, 0.0);
+    std::vector<int> size(n, 0);
+    auto recount = [&] {
+        std::fill(tot.begin(), tot.end(), 0.0);
+        std::fill(size.begin(), size.end(), 0);
+        for (int v = 0; v < n; ++v) { tot[comm[v]] += G.k[v]; ++size[comm[v]]; }
+    };
+    recount();
+
+    double bestQ = modularity(G, comm, nc);
+    std::vector<int> best = comm, next(n);
+    const int workers = std::max(1, std::min(workerCount(), n / 4096 + 1));
+    std::vector<std::vector<double>> acc(workers);
+
+    for (int it = 0; it < 24; ++it) {
+        std::vector<int> moved(workers, 0);
+        parallelFor(workers, [&](int wk) {
+            auto& a = acc[wk];
+            a.assign(n, 0.0);
+            std::vector<int> touched;
+            int lo = (int)((long long)n * wk / workers), hi = (int)((long long)n * (wk + 1) / workers);
+            for (int v = lo; v < hi; ++v) {
+                const int c = comm[v];
+                touched.clear();
+                for (int e = G.xadj[v]; e < G.xadj[v + 1]; ++e) {
+                    int d = comm[G.adj[e]];
+                    if (a[d] == 0.0) touched.push_back(d);
+                    a[d] += G.w[e];
+                }
+                const double kv = G.k[v];
+                double stay = a[c] - kv * (tot[c] - kv) / G.m2;
+                int target = c;
+                double gain = stay;
+                for (int d : touched) {
+                    if (d == c) continue;
+                    double g = a[d] - kv * tot[d] / G.m2;
+                    if (g > gain + 1e-12 || (g == gain && target != c && d < target)) { gain = g; target = d; }
+                }
+                // Екі синглтон бір-біріне ауыспасын
+                if (target != c && size[c] == 1 && size[target] == 1 && target > c) target = c;
+                next[v] = target;
+                moved[wk] += (target != c);
+                for (int d : touched) a[d] = 0.0;
+            }
+        });
+        int total = std::accumulate(moved.begin(), moved.end(), 0);
+        if (total == 0) break;
+        comm.swap(next);
+        recount();
+        double q = modularity(G, comm, n);
+        if (q > bestQ + 1e-9) { bestQ = q; best = comm; }
+        else if (q < bestQ - 1e-3) break;       // тербеліс — тоқтаймыз
+        if (total < n / 1000 + 1) break;
+    }
+    comm = best;
+    return bestQ;
+}
+
+// Қауымдастықтарды бір төбеге жинау
+WGraph aggregate(const WGraph& G, const std::vector<int>& comm, int nc) {
+    WGraph C;
+    C.k.assign(nc, 0.0);
+    C.self.assign(nc, 0.0);
+    C.xadj.assign(nc + 1, 0);
+    C.m2 = G.m2;
+    std::vector<std::vector<int>> members(nc);
+    for (int v = 0; v < G.n(); ++v) members[comm[v]].push_back(v);
+    std::vector<int> where(nc, -1);
+    for (int c = 0; c < nc; ++c) {
+        int start = (int)C.adj.size();
+        for (int v : members[c]) {
+            C.k[c]    += G.k[v];
+            C.self[c] += G.self[v];
+            for (int e = G.xadj[v]; e < G.xadj[v + 1]; ++e) {
+                int d = comm[G.adj[e]];
+                if (d == c) { C.self[c] += G.w[e]; continue; }
+                if (where[d] >= start) { C.w[where[d]] += G.w[e]; continue; }
+                where[d] = (int)C.adj.size();
+                C.adj.push_back(d);
+                C.w.push_back(G.w[e]);
+            }
+        }
+        C.xadj[c + 1] = (int)C.adj.size();
+    }
+    return C;
+}
+
+} // namespace
+
+double Communities::louvain(const Csr& out, const Csr& in, std::vector<int>& comm, int maxLevels) {
+    const int n = out.n();
+    if ((int)comm.size() != n) { comm.resize(n); std::iota(comm.begin(), comm.end(), 0); }
+    if (n == 0) return 0.0;
+
+    WGraph G = fromCsr(out, in);
+    if (G.m2 == 0.0) { std::iota(comm.begin(), comm.end(), 0); return 0.0; }
+
+    // Деңгей 0 жылы стартпен; кейінгі деңгейлер синглтоннан басталады
+    std::vector<int> level = comm;
+    double q = localMoving(G, level);
+    int nc = compact(level);
+    comm = level;
+
+    for (int l = 1; l < maxLevels; ++l) {
+        G = aggregate(G, level, nc);
+        level.resize(nc);
+        std::iota(level.begin(), level.end(), 0);
+        double q2 = localMoving(G, level);
+        int nc2 = compact(level);
+        if (nc2 == nc || q2 <= q + 1e-7) break;
+        for (int& c : comm) c = level[c];
+        q = q2;
+        nc = nc2;
+    }
+    return q;
+}
+
+// ----------------------------------------------------------------------------
+
+CommunityWorker::CommunityWorker() : worker(&CommunityWorker::compute) {}
+
+std::shared_ptr<CommunityResult> CommunityWorker::compute(const GraphSnapshot& snap,
+                                                          const std::shared_ptr<const CommunityResult>& prev) {
+    auto t0 = std::chrono::steady_clock::now();
+    auto res = std::make_shared<CommunityResult>();
+    const int n = snap.count();
+    res->ids.resize(n);
+    for (int s = 0; s < n; ++s) res->ids[s] = snap.getNodes()[s].id;
+
+    Csr out, in;
+    buildCsr(snap.getEdges(), n, out, in);
+
+    // Жылы старт: бұрынғы қауымдастық id бойынша, жаңалары — өз алдына
+    res->comm.resize(n);
+    if (prev) {
+        std::unordered_map<int, int> prevComm;
+        prevComm.reserve(prev->ids.size());
+        for (size_t s = 0; s < prev->ids.size(); ++s) prevComm.emplace(prev->ids[s], prev->comm[s]);
+        // Тапсырмалар жойылғаннан кейін ескі белгілер n-нен асуы мүмкін:
+        // [0, n) аралығына тығыз қайта нөмірленеді
+        std::unordered_map<int, int> dense;
+        dense.reserve(prev->count);
+        int next = 0;
+        for (int s = 0; s < n; ++s) {
+            auto it = prevComm.find(res->ids[s]);
+            if (it == prevComm.end()) { res->comm[s] = next++; continue; }   // жаңа тапсырма — өз алдына
+            auto ins = dense.emplace(it->second, next);
+            if (ins.second) ++next;
+            res->comm[s] = ins.first->second;
+        }
+    } else {
+        std::iota(res->comm.begin(), res->comm.end(), 0);
+    }
+
+    res->modularity = Communities::louvain(out, in, res->comm);
+    res->count = n ? *std::max_element(res->comm.begin(), res->comm.end()) + 1 : 0;
+    res->key.assign(res->count, INT_MAX);
+    for (int s = 0; s < n; ++s) res->key[res->comm[s]] = std::min(res->key[res->comm[s]], res->ids[s]);
+    res->ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return res;
+}
+
+// ----------------------------------------------------------------------------
+
+// Фибоначчи сферасынан бос орталықтардан ең алыс нүкте
+glm::vec3 CommunityLayout::pickCenter(float worldR) const {
+    const int kCand = 64;
+    const float golden = 2.39996323f;
+    glm::vec3 best(0.0f);
+    float bestD = -1.0f;
+    const int salt = (int)centers.size();
+    for (int i = 0; i < kCand; ++i) {
+        float y = 1.0f - 2.0f * (i + 0.5f) / kCand;
+        float r = std::sqrt(std::max(0.0f, 1.0f - y * y));
+        float th = golden * (i + salt * 7);
+        glm::vec3 p = glm::vec3(r * std::cos(th), y, r * std::sin(th)) * (worldR * 0.75f);
+        float d = 1e9f;
+        for (const auto& kv : centers) d = std::min(d, glm::length(kv.second - p));
+        if (d > bestD) { bestD = d; best = p; }
+    }
+    return best;
+}
+
+void CommunityLayout::apply(Graph& g, const std::vector<int>& commOfSlot, const std::vector<int>& keyOfComm) {
+    const int n = g.count();
+    const float worldR = std::max(1.2f, 0.28f * std::cbrt((float)std::max(1, n)));
+
+    // Жойылған қауымдастықтардың орталықтары — pickCenter оларды айналып өтпесін
+    std::unordered_set<int> live(keyOfComm.begin(), keyOfComm.end());
+    for (auto it = centers.begin(); it != centers.end(); )
+        it = live.count(it->first) ? std::next(it) : centers.erase(it);
+
+    std::vector<int> size(keyOfComm.size(), 0);
+    for (int s = 0; s < n; ++s) if (commOfSlot[s] >= 0) ++size[commOfSlot[s]];
+
+    std::mt19937 rng(12345u + (unsigned)n);
+    std::uniform_real_distribution<float> U(-1.0f, 1.0f);
+    for (int s = 0; s < n; ++s) {
+        int c = commOfSlot[s];
+        if (c < 0) continue;
+        auto it = centers.find(keyOfComm[c]);
+        if (it == centers.end()) it = centers.emplace(keyOfComm[c], pickCenter(worldR)).first;
+
+        const float R = 0.10f + 0.06f * std::cbrt((float)size[c]);
+        const glm::vec3& base = g.getNodes()[s].basePos;
+        if (glm::length(base - it->second) <= R) continue;      // аймағында — тимейміз
+
+        glm::vec3 off;
+        do { off = glm::vec3(U(rng), U(rng), U(rng)); } while (glm::dot(off, off) > 1.0f);
+        g.setBasePos(s, it->second + off * R);
+    }
+}
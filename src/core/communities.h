@@ -0,0 +1,53 @@
+#pragma once
+#include "traversal.h"
+#include "snapshot_worker.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+// Қауымдастықтарды табу (Louvain, бағытсыз). Жергілікті жылжу параллель
+// және синхронды: әр кезеңде барлық төбе алдыңғы күйге қарап шешеді,
+// тербелмес үшін синглтондар тек кіші белгіге ауысады (min-label).
+// Содан соң қауымдастықтар бір төбеге жиналып, келесі деңгей басталады.
+namespace Communities {
+    // comm — бастапқы бөлу (жылы старт); өлшемі n болмаса әр төбе өз алдына.
+    // Нәтиже: 0..k-1 нөмірленген қауымдастықтар, модулярлық қайтады
+    double louvain(const Csr& out, const Csr& in, std::vector<int>& comm, int maxLevels = 8);
+}
+
+struct CommunityResult {
+    std::vector<int> ids;           // snapshot кезіндегі slot → id
+    std::vector<int> comm;          // slot → қауымдастық
+    std::vector<int> key;           // қауымдастық → тұрақты кілт (ең кіші id)
+    int    count = 0;
+    double modularity = 0.0;
+    double ms = 0.0;
+};
+
+class CommunityWorker {
+public:
+    CommunityWorker();
+
+    void request(const Graph& g) { worker.request(g); }
+    std::shared_ptr<const CommunityResult> latest() const { return worker.latest(); }
+    bool busy() const { return worker.busy(); }
+
+private:
+    static std::shared_ptr<CommunityResult> compute(const GraphSnapshot& snap,
+                                                    const std::shared_ptr<const CommunityResult>& prev);
+    SnapshotWorker<CommunityResult> worker;
+};
+
+// Әр қауымдастыққа өз аймағы: орталық бір рет таңдалады (бар орталықтардан
+// ең алысы), аймағынан тыс тұрған тапсырмалар ғана қайта орналасады.
+class CommunityLayout {
+public:
+    // comm — ағымдағы slot-тар бойынша (−1 — белгісіз, тимейміз)
+    void apply(Graph& g, const std::vector<int>& commOfSlot, const std::vector<int>& keyOfComm);
+    void reset() { centers.clear(); }
+
+private:
+    glm::vec3 pickCenter(float worldR) const;
+    std::unordered_map<int, glm::vec3> centers;     // кілт → орталық (тек ағымдағы кілттер)
+};
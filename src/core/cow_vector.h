@@ -0,0 +1,101 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+// Бөліктерге (chunk) бөлінген copy-on-write вектор.
+// Көшіру O(1) — каталог пен бөліктер ортақ қалады; жазу кезінде тек
+// ортақ каталог пен нақты бөлік қана көшіріледі (use_count > 1 болса).
+// operator[] тек оқиды. Жазу: жекелеген түзету — mut(i), бума (физика
+// циклі) — detach() бір рет COW шешеді де, тексерусіз MutSpan береді.
+template <class T, unsigned Bits = 10>
+class CowVector {
+public:
+    static constexpr size_t kChunk = size_t(1) << Bits;
+    static constexpr size_t kMask  = kChunk - 1;
+    using Chunk = std::vector<T>;
+    using Dir   = std::vector<std::shared_ptr<Chunk>>;
+
+    CowVector() : dir(std::make_shared<Dir>()) {}
+
+    size_t size()  const { return n; }
+    bool   empty() const { return n == 0; }
+    void   reserve(size_t) {}
+
+    const T& operator[](size_t i) const { return (*(*dir)[i >> Bits])[i & kMask]; }
+    const T& back() const { return (*this)[n - 1]; }
+    T&       mut(size_t i) { return chunkMut(i >> Bits)[i & kMask]; }    // бір элементке COW
+
+    // Бума жазуға көрініс: use_count тексерулері detach() ішінде бір рет өтеді.
+    // Келесі көшірмеге (snapshot) не push/pop-қа дейін жарамды; әр жіп өз
+    // элементтеріне жарыссыз жаза алады.
+    class MutSpan {
+        Dir* d;
+    public:
+        explicit MutSpan(Dir* d_) : d(d_) {}
+        T& operator[](size_t i) const { return (*(*d)[i >> Bits])[i & kMask]; }
+    };
+
+    void push_back(const T& v) {
+        size_t c = n >> Bits;
+        ownDir();
+        if (c == dir->size()) {
+            dir->push_back(std::make_shared<Chunk>());
+            dir->back()->reserve(kChunk);
+        }
+        chunkMut(c).push_back(v);
+        ++n;
+    }
+    void pop_back() {
+        size_t c = (n - 1) >> Bits;
+        Chunk& ch = chunkMut(c);
+        ch.pop_back();
+        if (ch.empty()) dir->pop_back();
+        --n;
+    }
+    void clear() { dir = std::make_shared<Dir>(); n = 0; }
+
+    // Барлық бөлікті жеке меншікке алу (тек ортақтары көшіріледі)
+    MutSpan detach() {
+        for (size_t c = 0; c < dir->size(); ++c) chunkMut(c);
+        return MutSpan(dir.get());
+    }
+
+    // Diff үшін: бөлік екі нұсқада да бір объект пе (демек өзгермеген)
+    size_t chunkCount() const { return dir->size(); }
+    bool sameChunk(const CowVector& o, size_t c) const {
+        return c < dir->size() && c < o.dir->size() && (*dir)[c] == (*o.dir)[c];
+    }
+
+    class Iter {
+        const CowVector* v; size_t i;
+    public:
+        Iter(const CowVector* v_, size_t i_) : v(v_), i(i_) {}
+        const T& operator*() const { return (*v)[i]; }
+        const T* operator->() const { return &(*v)[i]; }
+        Iter& operator++() { ++i; return *this; }
+        bool  operator!=(const Iter& o) const { return i != o.i; }
+        bool  operator==(const Iter& o) const { return i == o.i; }
+    };
+    Iter begin() const { return { this, 0 }; }
+    Iter end()   const { return { this, n }; }
+
+private:
+    void ownDir() {
+        if (dir.use_count() > 1) dir = std::make_shared<Dir>(*dir);
+    }
+    Chunk& chunkMut(size_t c) {
+        ownDir();
+        auto& p = (*dir)[c];
+        if (p.use_count() > 1) {
+            auto copy = std::make_shared<Chunk>();
+            copy->reserve(kChunk);
+            copy->assign(p->begin(), p->end());
+            p = std::move(copy);
+        }
+        return *p;
+    }
+
+    std::shared_ptr<Dir> dir;
+    size_t n = 0;
+};
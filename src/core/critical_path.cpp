@@ -0,0 +1,134 @@
+#include "critical_path.h"
+#include "graph.h"
+#include <algorithm>
+
+float CriticalPath::remaining(const Graph& g, int slot) const {
+    // Орындалған тапсырма жолды ұстамайды
+    return (g.getNodes()[slot].state == NodeState::Done) ? 0.0f : dur[slot];
+}
+
+float CriticalPath::earliestStart(int slot, const Graph& g) const {
+    return head[slot] - remaining(g, slot);
+}
+
+void CriticalPath::onNodeAdded(const Graph& g, int slot, float duration) {
+    dur.push_back(duration);
+    head.push_back(0.0f);
+    tail.push_back(0.0f);
+    float r = remaining(g, slot);
+    head[slot] = r;
+    tail[slot] = r;
+    rank.insert({ r, g.getNodes()[slot].id });
+    dirty = true;
+}
+
+void CriticalPath::onEdgeAdded(const Graph& g, int from, int to) {
+    propagateHead(g, to);
+    propagateTail(g, from);
+}
+
+void CriticalPath::onEdgeRemoved(const Graph& g, int from, int to) {
+    propagateHead(g, to);
+    propagateTail(g, from);
+}
+
+void CriticalPath::onRemainingChanged(const Graph& g, int slot) {
+    propagateHead(g, slot);
+    propagateTail(g, slot);
+}
+
+// Көп көзден таралу топологиялық рет бойынша: әр түйін ең көбі бір рет
+// есептеледі (жеке onRemainingChanged-тің k рет қайталануы емес)
+void CriticalPath::onRemainingChanged(const Graph& g, const std::vector<int>& slots) {
+    if (slots.empty()) return;
+    propagateOrdered<true>(g, slots.data(), slots.size());
+    propagateOrdered<false>(g, slots.data(), slots.size());
+}
+
+// Down: head, ұрпақтарға, рет өсуімен; әйтпесе tail, аталарға, рет кемуімен
+template <bool Down>
+void CriticalPath::propagateOrdered(const Graph& g, const int* seeds, size_t nSeeds) {
+    const auto& E = g.getEdges();
+    if (queued.size() < dur.size()) queued.resize(dur.size(), 0);
+    if (++epoch == 0) { std::fill(queued.begin(), queued.end(), 0); epoch = 1; }
+    // std heap — max-heap: Down кезінде рет терісімен
+    auto push = [&](int s) {
+        if (queued[s] == epoch) return;
+        queued[s] = epoch;
+        const long long o = g.topoOrder(s);
+        heap.push_back({ Down ? -o : o, s });
+        std::push_heap(heap.begin(), heap.end());
+    };
+    heap.clear();
+    for (size_t i = 0; i < nSeeds; ++i) push(seeds[i]);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end());
+        const int s = heap.back().second;
+        heap.pop_back();
+        float best = 0.0f;
+        if (Down) {
+            for (int e : g.inEdgesOf(s)) best = std::max(best, head[E[e].from]);
+            float h = remaining(g, s) + best;
+            if (h == head[s]) continue;
+            head[s] = h;
+            for (int e : g.outEdgesOf(s)) push(E[e].to);
+        } else {
+            for (int e : g.outEdgesOf(s)) best = std::max(best, tail[E[e].to]);
+            float t = remaining(g, s) + best;
+            if (t == tail[s]) continue;
+            setTail(g, s, t);
+            for (int e : g.inEdgesOf(s)) push(E[e].from);
+        }
+    }
+}
+
+void CriticalPath::onNodeRemoved(const Graph& g, int slot, int last) {
+    // Түйін бұл кезде оқшауланған (қабырғалары алынған)
+    rank.erase({ tail[slot], g.getNodes()[slot].id });
+    dur[slot]  = dur[last];
+    head[slot] = head[last];
+    tail[slot] = tail[last];
+    dur.pop_back();
+    head.pop_back();
+    tail.pop_back();
+    dirty = true;
+}
+
+// Бір көзден таралу да топологиялық реттегі үйме арқылы: ромб тәрізді
+// DAG-тарда LIFO стек бір түйінді әр өзгерген атасы үшін қайта есептер еді
+void CriticalPath::propagateHead(const Graph& g, int slot) { propagateOrdered<true>(g, &slot, 1); }
+void CriticalPath::propagateTail(const Graph& g, int slot) { propagateOrdered<false>(g, &slot, 1); }
+
+void CriticalPath::setTail(const Graph& g, int slot, float t) {
+    int id = g.getNodes()[slot].id;
+    rank.erase({ tail[slot], id });
+    tail[slot] = t;
+    rank.insert({ t, id });
+    dirty = true;
+}
+
+const std::vector<int>& CriticalPath::path(const Graph& g) const {
+    if (!dirty) return cache;
+    dirty = false;
+    cache.clear();
+    if (rank.empty() || rank.rbegin()->first <= 0.0f) return cache;
+
+    const auto& E = g.getEdges();
+    auto maxSucc = [&](int s) {
+        int best = -1;
+        for (int e : g.outEdgesOf(s)) {
+            int t = E[e].to;
+            if (best < 0 || tail[t] > tail[best]) best = t;
+        }
+        return best;
+    };
+
+    // Ең ұзын tail-дан бастап, әр қадамда ең ұзын tail-ы бар ізбасарға өтеміз
+    int s = g.slotOf(rank.rbegin()->second);
+    while (s >= 0 && remaining(g, s) <= 0.0f) s = maxSucc(s);   // алдыңғы Done-дарды өткіземіз
+    while (s >= 0 && tail[s] > 0.0f) {
+        cache.push_back(s);
+        s = maxSucc(s);
+    }
+    return cache;
+}
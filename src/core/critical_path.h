@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include <set>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+class Graph;
+
+// Критикалық жол (CPM) — инкременталды түрде ұсталады.
+// head = ең ерте аяқталу (EF), tail = түйіннен соңғы тапсырмаға дейінгі
+// қалған жұмыс. LS = makespan - tail. Өзгеріс тек әсер еткен
+// ұрпақтарға (head) және аталарға (tail) ғана таралады.
+class CriticalPath {
+public:
+    // Graph хуктары (slot индекстерімен)
+    void onNodeAdded(const Graph& g, int slot, float duration);
+    void onEdgeAdded(const Graph& g, int from, int to);
+    void onEdgeRemoved(const Graph& g, int from, int to);
+    void onRemainingChanged(const Graph& g, int slot);
+    void onRemainingChanged(const Graph& g, const std::vector<int>& slots);   // топтық, бір таралу
+    void onNodeRemoved(const Graph& g, int slot, int last);   // swap-remove алдында
+
+    float duration(int slot)       const { return dur[slot]; }
+    float earliestFinish(int slot) const { return head[slot]; }
+    float earliestStart(int slot, const Graph& g) const;
+    float latestStart(int slot)    const { return makespan() - tail[slot]; }
+    float makespan() const { return rank.empty() ? 0.0f : rank.rbegin()->first; }
+
+    // Ағымдағы критикалық жол (slot-тар, бастан соңға қарай), кэштелген
+    const std::vector<int>& path(const Graph& g) const;
+
+private:
+    float remaining(const Graph& g, int slot) const;
+    void  propagateHead(const Graph& g, int slot);
+    void  propagateTail(const Graph& g, int slot);
+    void  setTail(const Graph& g, int slot, float t);
+    template <bool Down> void propagateOrdered(const Graph& g, const int* seeds, size_t nSeeds);
+
+    std::vector<float> dur;     // толық ұзақтық
+    std::vector<float> head;    // EF
+    std::vector<float> tail;    // қалған ең ұзын тізбек (өзін қоса)
+    std::set<std::pair<float,int>> rank;   // (tail, id) — makespan = max
+
+    mutable std::vector<int> cache;
+    mutable bool dirty = true;
+    std::vector<std::pair<long long,int>> heap;   // таралу үймесі: (топ. рет, slot)
+    std::vector<uint32_t> queued;                  // epoch белгілері
+    uint32_t epoch = 0;
+};
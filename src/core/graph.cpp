@@ -1,8 +1,11 @@
 #include "graph.h"
+#include "../utils/parallel.h"
 #include <glm/glm.hpp>
 #include <random>
 #include <cmath>
 #include <algorithm>
+#include <utility>
+#include <cstdio>
 
 static std::mt19937& rng() {
     static thread_local std::mt19937 gen{ std::random_device{}() };
@@ -41,44 +44,353 @@ Node Graph::makeRandomNode() {
 }
 
 Graph::Graph(int initialCount) {
+    attrs.addColumn("name",  AttributeStore::Type::Text);   // қайталанбайды — сөздіксіз
+    attrs.addColumn("owner", AttributeStore::Type::Str);
+    attrs.addColumn("queue", AttributeStore::Type::Str);
     nodes.reserve(initialCount);
-    for (int i = 0; i < initialCount; ++i) {
-        Node nd = makeRandomNode();
-        idIndex[nd.id] = nodes.size();
-        nodes.push_back(nd);
-    }
-    rebuildRingEdges();
+    for (int i = 0; i < initialCount; ++i) addTask();
 }
 
-int Graph::addTask() {
-    Node nd = makeRandomNode();
-    idIndex[nd.id] = nodes.size();
+int Graph::insertNode(const Node& nd, float duration) {
+    int slot = (int)nodes.size();
+    idIndex[nd.id] = slot;
     nodes.push_back(nd);
-    rebuildRingEdges();
+    outAdj.emplace_back();
+    inAdj.emplace_back();
+    stateIdx.onNodeAdded(slot, nd.state);
+    grp.onNodeAdded(slot);
+    topo.onNodeAdded(slot);
+    attrs.onNodeAdded(slot);
+    shards.onNodeAdded(*this, slot);
+    ++topoVer;
+    cpm.onNodeAdded(*this, slot, duration);
+
+    GraphChange c;
+    c.op = ChangeOp::AddNode;
+    c.id = nd.id;
+    c.duration = duration;
+    c.basePos  = nd.basePos;
+    c.state    = nd.state;
+    record(c);
     return nd.id;
 }
 
+// Журнал шектеулі: шектің екі еселігіне жеткенде ескі жартысы бір erase-пен
+// тасталады (амортизацияланған O(1)). Тасталған нұсқалардан дельта құрылмайды
+void Graph::record(GraphChange c) {
+    c.version = ++ver;
+    journal.push_back(std::move(c));
+    if (journal.size() >= 2 * historyLimit) journal.erase(journal.begin(), journal.end() - historyLimit);
+}
+
+// Демонстрация үшін: жаңа тапсырма бұрынғы 1–2 тапсырмаға тәуелді (DAG сақталады)
+int Graph::addTask() {
+    std::uniform_real_distribution<float> D(1.0f, 5.0f);
+    std::vector<int> deps;
+    int n = (int)nodes.size();
+    if (n > 0) {
+        std::uniform_int_distribution<int> P(0, n - 1);
+        int k = (n > 3) ? 2 : 1;
+        for (int i = 0; i < k; ++i) deps.push_back(std::as_const(nodes)[P(rng())].id);
+    }
+
+    Node nd = makeRandomNode();
+    int stage = nextDemoStage(nd.basePos);
+    nd.pos = nd.basePos;
+    int id = insertNode(nd, D(rng()));
+    for (int d : deps) addDependency(d, id);
+    int slot = slotOf(id);
+    grp.assign(slot, stage, nd.state, nd.basePos);
+
+    // Демо атрибуттары: атау stage ішіндегі реттен, иесі мен кезегі кездейсоқ
+    static const char* kOwners[] = { "ingest", "etl", "ml", "report", "infra" };
+    static const char* kQueues[] = { "cpu", "gpu", "io" };
+    char name[48];
+    snprintf(name, sizeof(name), "job%d/stage%d/t%d", demoJob, stage, demoStageTasks);
+    attrs.setStr(kAttrName,  slot, name);
+    attrs.setStr(kAttrOwner, slot, kOwners[rng()() % 5]);
+    attrs.setStr(kAttrQueue, slot, kQueues[rng()() % 3]);
+    return id;
+}
+
+// Әр stage ≤ 8 тапсырма, әр job ≤ 4 stage; stage тапсырмалары бір маңда
+int Graph::nextDemoStage(glm::vec3& basePos) {
+    int n = std::max(1, (int)nodes.size());
+    float worldR = std::max(1.2f, 0.28f * std::cbrt((float)n));
+    if (demoJob < 0 || demoJobStages >= 4) {
+        demoJob = grp.create(-1);
+        demoJobStages = 0;
+        demoAnchor = randomInSphere(worldR * 0.8f);
+    }
+    if (demoStage < 0 || demoStageTasks >= 8) {
+        demoStage = grp.create(demoJob);
+        demoStageTasks = 0;
+        demoStageAnchor = demoAnchor + randomInSphere(0.5f);
+        ++demoJobStages;
+    }
+    ++demoStageTasks;
+    basePos = demoStageAnchor + randomInSphere(0.3f);
+    return demoStage;
+}
+
+bool Graph::assignGroup(int taskId, int group) {
+    int s = slotOf(taskId);
+    if (s < 0 || group >= grp.size()) return false;
+    grp.assign(s, group, nodes[s].state, nodes[s].basePos);
+    return true;
+}
+
+glm::vec3 Graph::displayPos(int slot) const {
+    int top = grp.topCollapsed(grp.groupOf(slot));
+    return (top >= 0) ? grp.centroid(top) : nodes[slot].pos;
+}
+
+int Graph::addTask(const std::vector<int>& deps, float duration) {
+    int id = insertNode(makeRandomNode(), duration);
+    for (int d : deps) addDependency(d, id);
+    return id;
+}
+
+DepStatus Graph::addDependency(int fromId, int toId) {
+    int a = slotOf(fromId), b = slotOf(toId);
+    if (a < 0 || b < 0) return DepStatus::MissingId;
+    if (a == b) return DepStatus::Cycle;
+    for (int e : outAdj[a]) if (edges[e].to == b) return DepStatus::Duplicate;
+    if (!topo.tryAddEdge(*this, a, b)) return DepStatus::Cycle;     // Pearce–Kelly іздеуі from-ға жетті
+    linkEdge(a, b);
+    cpm.onEdgeAdded(*this, a, b);
+
+    GraphChange c;
+    c.op = ChangeOp::AddEdge;
+    c.id = fromId;
+    c.other = toId;
+    record(c);
+    return DepStatus::Added;
+}
+
+bool Graph::removeDependency(int fromId, int toId) {
+    int a = slotOf(fromId), b = slotOf(toId);
+    if (a < 0 || b < 0) return false;
+    for (int e : outAdj[a]) {
+        if (std::as_const(edges)[e].to != b) continue;
+        unlinkEdge(e);
+        cpm.onEdgeRemoved(*this, a, b);
+
+        GraphChange c;
+        c.op = ChangeOp::RemoveEdge;
+        c.id = fromId;
+        c.other = toId;
+        record(c);
+        return true;
+    }
+    return false;
+}
+
+// Дельтадан қалпына келтіру: id сақталады, тәуелділіктер бөлек келеді
+int Graph::restoreTask(int id, float duration, const glm::vec3& basePos, NodeState st) {
+    if (idIndex.count(id)) return -1;
+    Node nd{};
+    nd.id = id;
+    nd.basePos = basePos;
+    nd.pos = basePos;
+    nd.vel = glm::vec3(0.0f);
+    nd.state = st;
+    nextId = std::max(nextId, id + 1);
+    return insertNode(nd, duration);
+}
+
+void Graph::linkEdge(int from, int to) {
+    int e = (int)edges.size();
+    edges.push_back({ from, to });
+    outAdj[from].push_back(e);
+    inAdj[to].push_back(e);
+    ++topoVer;
+}
+
+static void replaceIn(std::vector<int>& v, int oldV, int newV) {
+    for (int& x : v) if (x == oldV) { x = newV; return; }
+}
+static void eraseIn(std::vector<int>& v, int x) {
+    for (size_t i = 0; i < v.size(); ++i)
+        if (v[i] == x) { v[i] = v.back(); v.pop_back(); return; }
+}
+
+// Қабырғаны swap-remove арқылы алып тастау — тек көршілер жаңартылады
+void Graph::unlinkEdge(int e) {
+    ++topoVer;
+    eraseIn(outAdj[edges[e].from], e);
+    eraseIn(inAdj[edges[e].to], e);
+    int last = (int)edges.size() - 1;
+    if (e != last) {
+        edges.mut(e) = edges[last];
+        replaceIn(outAdj[edges[e].from], last, e);
+        replaceIn(inAdj[edges[e].to], last, e);
+    }
+    edges.pop_back();
+}
+
 bool Graph::removeTask(int id) {
     auto it = idIndex.find(id);
     if (it == idIndex.end()) return false;
 
-    size_t idx = it->second;
-    size_t last = nodes.size() - 1;
+    int idx  = (int)it->second;
+    int last = (int)nodes.size() - 1;
+
+    // Алдымен түйінді оқшаулаймыз
+    while (!outAdj[idx].empty()) {
+        int e = outAdj[idx].back(), to = edges[e].to;
+        unlinkEdge(e);
+        cpm.onEdgeRemoved(*this, idx, to);
+    }
+    while (!inAdj[idx].empty()) {
+        int e = inAdj[idx].back(), from = edges[e].from;
+        unlinkEdge(e);
+        cpm.onEdgeRemoved(*this, from, idx);
+    }
+    cpm.onNodeRemoved(*this, idx, last);
+    grp.onNodeRemoved(idx, last, nodes[idx].state, nodes[idx].basePos);
+    topo.onNodeRemoved(idx, last);
+    attrs.onNodeRemoved(idx, last);
+    shards.onNodeRemoved(idx, last);
+    ++topoVer;
+    stateIdx.onNodeRemoved(idx, last);
 
     if (idx != last) {
-        std::swap(nodes[idx], nodes[last]);
+        for (int e : outAdj[last]) edges.mut(e).from = idx;
+        for (int e : inAdj[last])  edges.mut(e).to   = idx;
+        outAdj[idx] = std::move(outAdj[last]);
+        inAdj[idx]  = std::move(inAdj[last]);
+        std::swap(nodes.mut(idx), nodes.mut(last));
         idIndex[nodes[idx].id] = idx;
     }
     nodes.pop_back();
-    idIndex.erase(it);
-    rebuildRingEdges();
+    outAdj.pop_back();
+    inAdj.pop_back();
+    idIndex.erase(id);
+
+    GraphChange c;
+    c.op = ChangeOp::RemoveNode;
+    c.id = id;
+    record(c);
+    return true;
+}
+
+bool Graph::setNodeState(int id, NodeState s) {
+    auto it = idIndex.find(id);
+    if (it == idIndex.end()) return false;
+    if (std::as_const(nodes)[it->second].state == s) return false;
+    Node& nd = nodes.mut(it->second);
+    bool wasDone = (nd.state == NodeState::Done);
+    grp.onStateChanged((int)it->second, nd.state, s);
+    nd.state = s;
+    stateIdx.onStateChanged((int)it->second, s);
+    if (wasDone != (s == NodeState::Done)) cpm.onRemainingChanged(*this, (int)it->second);
+
+    GraphChange c;
+    c.op = ChangeOp::State;
+    c.id = id;
+    c.state = s;
+    record(c);
     return true;
 }
 
-void Graph::setNodeState(int id, NodeState s) {
+void Graph::setBasePos(int slot, const glm::vec3& p) {
+    Node& nd = nodes.mut(slot);
+    grp.onBaseMoved(slot, nd.basePos, p);
+    nd.basePos = p;
+}
+
+int Graph::slotOf(int id) const {
     auto it = idIndex.find(id);
-    if (it == idIndex.end()) return;
-    nodes[it->second].state = s;
+    return (it == idIndex.end()) ? -1 : (int)it->second;
+}
+
+void Graph::downstreamOf(int id, std::vector<int>& outSlots) const {
+    int s = slotOf(id);
+    if (s < 0) { outSlots.clear(); return; }
+    reach.descendants(*this, s, outSlots);
+}
+
+void Graph::upstreamOf(int id, std::vector<int>& outSlots) const {
+    int s = slotOf(id);
+    if (s < 0) { outSlots.clear(); return; }
+    reach.ancestors(*this, s, outSlots);
+}
+
+void Graph::traverse(const std::vector<int>& ids, TraversalEngine::Dir dir, int maxDepth,
+                     std::vector<int>& outSlots) const {
+    std::vector<int> src;
+    src.reserve(ids.size());
+    for (int id : ids) { int s = slotOf(id); if (s >= 0) src.push_back(s); }
+    trav.sync(*this);
+    trav.bfs(src, dir, maxDepth, outSlots);
+}
+
+void Graph::neighbourhood(int id, int hops, std::vector<int>& outSlots) const {
+    traverse({ id }, TraversalEngine::Dir::Both, hops, outSlots);
+}
+
+// Топтық күй өзгерісі: бір өтуде күйлер қойылады, содан кейін топ
+// агрегаттары мен CPM бір рет жаңарады, журналға бір StateBatch жазылады
+int Graph::setSlotStates(const std::vector<int>& slots, NodeState s) {
+    std::vector<int> changed, doneFlip, ids;
+    std::vector<NodeState> from;
+    for (int sl : slots) {
+        if (std::as_const(nodes)[sl].state == s) continue;
+        Node& nd = nodes.mut(sl);               // сирек жазу: тек қозғалған бөліктер көшіріледі
+        if ((nd.state == NodeState::Done) != (s == NodeState::Done)) doneFlip.push_back(sl);
+        changed.push_back(sl);
+        from.push_back(nd.state);
+        ids.push_back(nd.id);
+        nd.state = s;
+        stateIdx.onStateChanged(sl, s);
+    }
+    if (changed.empty()) return 0;
+    grp.onStatesChanged(changed, from, s);
+    cpm.onRemainingChanged(*this, doneFlip);
+
+    GraphChange c;
+    c.op = ChangeOp::StateBatch;
+    c.state = s;
+    c.ids = std::move(ids);
+    record(std::move(c));
+    return (int)changed.size();
+}
+
+int Graph::setNodeStates(const std::vector<int>& ids, NodeState s) {
+    std::vector<int> slots;
+    slots.reserve(ids.size());
+    for (int id : ids) { int sl = slotOf(id); if (sl >= 0) slots.push_back(sl); }
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+    return setSlotStates(slots, s);
+}
+
+int Graph::markSubtree(int id, NodeState s) {
+    std::vector<int> slots;
+    traverse({ id }, TraversalEngine::Dir::Down, -1, slots);
+    return setSlotStates(slots, s);
+}
+
+int Graph::markUpstream(int id, NodeState s) {
+    std::vector<int> slots;
+    traverse({ id }, TraversalEngine::Dir::Up, -1, slots);
+    return setSlotStates(slots, s);
+}
+
+GraphSnapshot Graph::snapshot() const {
+    GraphSnapshot snap;
+    snap.nodes   = nodes;
+    snap.edges   = edges;
+    snap.topoVer = topoVer;
+    snap.ver     = ver;
+    return snap;
+}
+
+void Graph::trimHistory(unsigned long long upTo) {
+    auto it = std::upper_bound(journal.begin(), journal.end(), upTo,
+        [](unsigned long long v, const GraphChange& c) { return v < c.version; });
+    journal.erase(journal.begin(), it);
 }
 
 std::vector<int> Graph::ids() const {
@@ -89,58 +401,113 @@ std::vector<int> Graph::ids() const {
     return out;
 }
 
-void Graph::rebuildRingEdges() {
-    edges.clear();
-    int n = (int)nodes.size();
-    if (n < 2) return;
-    edges.reserve(n);
-    for (int i = 0; i < n; ++i) {
-        edges.push_back({ i, (i + 1) % n });
-    }
-}
+// Физика тұрақтылары
+static constexpr float kNodeRadius = 0.07f;
+static constexpr float kMinGap     = 0.03f;
+static constexpr float kMinDist    = 2.0f * kNodeRadius + kMinGap;
+static constexpr float kSepK       = 10.0f;
 
 void Graph::update(float dt) {
     if (dt <= 0.0f) return;
 
     const int n = (int)nodes.size();
     if (n == 0) return;
+    shards.maintain(*this);
 
     const float worldR = std::max(1.2f, 0.28f * std::cbrt((float)n));
     const float B = worldR + 0.6f;
-    const float maxSpeed = 0.7f;
 
-    const float nodeRadius = 0.07f;
-    const float minGap     = 0.03f;
-    const float minDist    = 2.0f * nodeRadius + minGap;
-    const float minDist2   = minDist * minDist;
-    const float sepK       = 10.0f;
+    // Жабық топтағы тапсырмалар қатырылады — физика тек белсенділерге
+    const int k = shards.parts();
+    std::vector<std::vector<int>> active(k);
+    std::vector<int> all;
+    all.reserve(n);
+    for (int i = 0; i < n; ++i)
+        if (!grp.hidden(i)) { active[shards.partOf(i)].push_back(i); all.push_back(i); }
 
-    const float jitterScale = 0.6f;
-    const float springNear  = 0.5f;
-    const float springFar   = 2.0f;
+    // Сепарация жаһандық: шардтар топологиялық, кеңістікте араласады
+    separate(all);
 
-    std::uniform_real_distribution<float> J(-1.0f, 1.0f);
+    // COW бір рет, цикл алдында: жіптер элемент сайын use_count тексермейді
+    // және бір бөлікті бірге көшіріп жібермейді
+    const auto W = nodes.detach();
+    parallelFor(k, [&](int p) { integrate(W, active[p], dt, B); });
+}
+
+// Кеңістіктік хэш-тор (ұяшық = kMinDist): counting sort бойынша ұяшық → slot-тар,
+// әр түйін тек 27 көрші ұяшықты қарайды. Әр түйін өз үдеуін ғана жазады —
+// жұпты екі жақ бөлек есептейді, сондықтан жіптер жарыспайды.
+// Хэш соқтығысы артық үміткер ғана береді (қашықтық сүзеді).
+void Graph::separate(const std::vector<int>& active) {
+    const int m = (int)active.size();
+    const auto& N = nodes;
+    sepAcc.assign(N.size(), glm::vec3(0.0f));
+    if (m < 2) return;
 
-    // Жұптық сепарация жинақтағышы
-    std::vector<glm::vec3> sepAcc(n, glm::vec3(0.0f));
-    for (int i = 0; i < n; ++i) {
-        for (int j = i + 1; j < n; ++j) {
-            glm::vec3 d = nodes[i].pos - nodes[j].pos;
-            float dist2 = glm::dot(d, d);
-            if (dist2 > 1e-10f && dist2 < minDist2) {
-                float dist = std::sqrt(dist2);
-                glm::vec3 dir = d / dist;
-                float overlap = (minDist - dist);
-                glm::vec3 acc = dir * (sepK * overlap);
-                sepAcc[i] += acc;
-                sepAcc[j] -= acc;
+    unsigned buckets = 1;
+    while (buckets < 2u * (unsigned)m) buckets <<= 1;
+    const unsigned mask = buckets - 1;
+    const float inv = 1.0f / kMinDist;
+    auto cellOf = [&](const glm::vec3& p) {
+        return glm::ivec3((int)std::floor(p.x * inv), (int)std::floor(p.y * inv), (int)std::floor(p.z * inv));
+    };
+    auto hashOf = [&](const glm::ivec3& c) {
+        return ((unsigned)c.x * 73856093u ^ (unsigned)c.y * 19349663u ^ (unsigned)c.z * 83492791u) & mask;
+    };
+
+    cellStart.assign(buckets + 1, 0);
+    for (int s : active) ++cellStart[hashOf(cellOf(N[s].pos)) + 1];
+    for (unsigned b = 0; b < buckets; ++b) cellStart[b + 1] += cellStart[b];
+    cellItems.resize(m);
+    {
+        std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+        for (int s : active) cellItems[fill[hashOf(cellOf(N[s].pos))]++] = s;
+    }
+
+    const float minDist2 = kMinDist * kMinDist;
+    const int kGrain = 1024;
+    parallelFor((m + kGrain - 1) / kGrain, [&](int ch) {
+        const int lo = ch * kGrain, hi = std::min(m, lo + kGrain);
+        for (int ai = lo; ai < hi; ++ai) {
+            const int i = active[ai];
+            const glm::vec3 pi = N[i].pos;
+            const glm::ivec3 c = cellOf(pi);
+            unsigned seen[27];
+            int nSeen = 0;
+            glm::vec3 acc(0.0f);
+            for (int dz = -1; dz <= 1; ++dz)
+            for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx) {
+                const unsigned h = hashOf(c + glm::ivec3(dx, dy, dz));
+                if (std::find(seen, seen + nSeen, h) != seen + nSeen) continue;   // бір бакет екі рет емес
+                seen[nSeen++] = h;
+                for (int q = cellStart[h]; q < cellStart[h + 1]; ++q) {
+                    const int j = cellItems[q];
+                    if (j == i) continue;
+                    glm::vec3 d = pi - N[j].pos;
+                    float dist2 = glm::dot(d, d);
+                    if (dist2 > 1e-10f && dist2 < minDist2) {
+                        float dist = std::sqrt(dist2);
+                        acc += (d / dist) * (kSepK * (kMinDist - dist));
+                    }
+                }
             }
+            sepAcc[i] = acc;
         }
-    }
+    });
+}
+
+// Бір шардтың интеграциясы (түйін сайын тәуелсіз)
+void Graph::integrate(CowVector<Node>::MutSpan W, const std::vector<int>& slots, float dt, float B) {
+    const float maxSpeed = 0.7f;
+
+    const float jitterScale = 0.6f;
+    const float springNear  = 0.5f;
+    const float springFar   = 2.0f;
 
-    // Интеграция
-    for (int i = 0; i < n; ++i) {
-        auto& nd = nodes[i];
+    std::uniform_real_distribution<float> J(-1.0f, 1.0f);
+    for (int slot : slots) {
+        auto& nd = W[slot];
 
         glm::vec3 a(J(rng()), J(rng()), J(rng()));
         a *= jitterScale;
@@ -160,7 +527,7 @@ void Graph::update(float dt) {
             default: break;
         }
 
-        a += sepAcc[i];
+        a += sepAcc[slot];
 
         nd.vel += a * dt;
         float sp = glm::length(nd.vel);
@@ -1,37 +1,161 @@
 #pragma once
 #include "node.h"
 #include "edge.h"
+#include "cow_vector.h"
+#include "critical_path.h"
+#include "state_index.h"
+#include "task_groups.h"
+#include "reachability.h"
+#include "graph_delta.h"
+#include "partitioner.h"
+#include "topo_order.h"
+#include "traversal.h"
+#include "attributes.h"
 #include <vector>
 #include <unordered_map>
+#include <algorithm>
+
+// Графтың қатырылған нұсқасы — құрылымдық ортақтастықпен, O(1) жасалады.
+// Фондық талдау тірі граф өзгере берсе де осы нұсқаны қауіпсіз оқи алады.
+// Тек const қолжетімділік: const емес оқу бөліктерді бекер көшірер еді.
+class GraphSnapshot {
+    CowVector<Node> nodes;
+    CowVector<Edge> edges;
+    unsigned long long topoVer = 0;
+    unsigned long long ver = 0;
+    friend class Graph;
+
+public:
+    const CowVector<Node>& getNodes() const { return nodes; }
+    const CowVector<Edge>& getEdges() const { return edges; }
+    int  count() const { return (int)nodes.size(); }
+    unsigned long long topologyVersion() const { return topoVer; }
+    unsigned long long version() const { return ver; }
+};
+
+// addDependency нәтижесі: қабылданбаса — себебі (шақырушы қайта іздемейді)
+enum class DepStatus : uint8_t {
+    Added,
+    MissingId,      // from не to жоқ
+    Duplicate,      // қабырға бар
+    Cycle,          // цикл жасар еді (from == to да)
+};
 
 class Graph {
-    std::vector<Node> nodes;
-    std::vector<Edge> edges;
+    CowVector<Node> nodes;
+    CowVector<Edge> edges;                   // from/to — slot индекстері
+    std::vector<std::vector<int>> outAdj;    // slot → шығыс қабырға индекстері
+    std::vector<std::vector<int>> inAdj;     // slot → кіріс қабырға индекстері
     std::unordered_map<int, size_t> idIndex;
     int nextId = 0;
 
+    CriticalPath cpm;
+    StateIndex   stateIdx;
+    TaskGroups   grp;
+    ReachSearch  reach;
+    TopoOrder    topo;
+    AttributeStore attrs;                // ыстық Node-тан тыс: атау, иесі, кезек
+    mutable TraversalEngine trav;       // CSR кэші — сұраныс кезінде жаңарады
+    GraphPartitioner shards;
+    unsigned long long topoVer = 0;      // құрылым өзгерген сайын өседі
+    unsigned long long ver = 0;          // әр журналданған өзгерісте өседі
+    std::vector<GraphChange> journal;    // version бойынша сұрыпталған
+    std::vector<glm::vec3> sepAcc;       // slot → сепарация үдеуі (кадр сайын)
+    std::vector<int> cellStart, cellItems;  // сепарацияның хэш-торы
+    size_t historyLimit = size_t(1) << 16;  // журнал шегі (ескі жазбалар түсіп қалады)
+
+    // Демо топтары: job → stage → task
+    int demoJob = -1, demoStage = -1;
+    int demoJobStages = 0, demoStageTasks = 0;
+    glm::vec3 demoAnchor{0.0f}, demoStageAnchor{0.0f};
+
     Node makeRandomNode();              // ✅ private member
+    int  insertNode(const Node& nd, float duration);
+    void record(GraphChange c);
+    int  setSlotStates(const std::vector<int>& slots, NodeState s);
+    void linkEdge(int from, int to);
+    void unlinkEdge(int e);
+    int  nextDemoStage(glm::vec3& basePos);
+    void separate(const std::vector<int>& active);
+    void integrate(CowVector<Node>::MutSpan W, const std::vector<int>& slots, float dt, float B);
 
 public:
+    // Әдепкі атрибут бағаналары (конструкторда осы ретпен құрылады)
+    static constexpr int kAttrName = 0, kAttrOwner = 1, kAttrQueue = 2;
+
     explicit Graph(int initialCount = 0);
 
     // Басқару
-    int  addTask();
+    int  addTask();                                          // демо: кездейсоқ тәуелділіктер
+    int  addTask(const std::vector<int>& deps, float duration);
     bool removeTask(int id);
+    DepStatus addDependency(int fromId, int toId);           // from аяқталмай to басталмайды
+    bool removeDependency(int fromId, int toId);
+    int  restoreTask(int id, float duration, const glm::vec3& basePos, NodeState st);
 
     // Күй
-    void setNodeState(int id, NodeState state);
+    bool setNodeState(int id, NodeState state);              // күй өзгерсе (журналға жазылса) true
+    int  setNodeStates(const std::vector<int>& ids, NodeState state);   // топтық; өзгергендер саны
+    void setBasePos(int slot, const glm::vec3& p);          // layout үшін (топ центроидтары жаңарады)
 
     // Кадр сайын жаңарту
     void update(float dt);              // ✅ дәл осы сигнатура
 
     // Көмекші/рендерге
-    const std::vector<Edge>& getEdges() const { return edges; }
-    std::vector<Node>&       getNodes()       { return nodes; }
-    const std::vector<Node>& getNodes() const { return nodes; }
+    const CowVector<Edge>& getEdges() const { return edges; }
+    CowVector<Node>&       getNodes()       { return nodes; }
+    const CowVector<Node>& getNodes() const { return nodes; }
     int  count() const { return (int)nodes.size(); }
     std::vector<int> ids() const;       // ✅ UI үшін
 
-    // Демонстрация үшін қарапайым ребра генерациясы
-    void rebuildRingEdges();
+    int  slotOf(int id) const;
+    const std::vector<int>& outEdgesOf(int slot) const { return outAdj[slot]; }
+    const std::vector<int>& inEdgesOf(int slot)  const { return inAdj[slot]; }
+
+    // Критикалық жол
+    const CriticalPath&     critical()     const { return cpm; }
+    const std::vector<int>& criticalPath() const { return cpm.path(*this); }
+    float makespan() const { return cpm.makespan(); }
+
+    // Күй санауыштары мен күй бойынша тізімдер
+    const StateIndex& states() const { return stateIdx; }
+    int countByState(NodeState s) const { return stateIdx.count(s); }
+
+    // Иерархиялық топтар (жабық топ бір proxy сфера болып сызылады)
+    int  createGroup(int parent = -1) { return grp.create(parent); }
+    bool assignGroup(int taskId, int group);
+    const TaskGroups& groups() const { return grp; }
+    TaskGroups&       groups()       { return grp; }
+    glm::vec3 displayPos(int slot) const;   // жасырын болса — proxy орны
+
+    // Жетімділік: "кім бөгелді" / "неге тәуелді" (нәтиже — slot-тар)
+    void downstreamOf(int id, std::vector<int>& outSlots) const;
+    void upstreamOf(int id, std::vector<int>& outSlots) const;
+    unsigned long long topologyVersion() const { return topoVer; }
+    long long topoOrder(int slot) const { return topo.order(slot); }   // from → to ⇒ кіші → үлкен
+
+    // Көп ағынды BFS (traversal.h): ірі ішкі графтарға операциялар
+    void traverse(const std::vector<int>& ids, TraversalEngine::Dir dir, int maxDepth,
+                  std::vector<int>& outSlots) const;
+    void neighbourhood(int id, int hops, std::vector<int>& outSlots) const;
+    int  markSubtree(int id, NodeState s);          // id + барлық ұрпақтары; өзгергендер саны
+    int  markUpstream(int id, NodeState s);         // id + барлық аталары
+
+    // Бағаналы атрибуттар (slot бойынша) — белгілер, іздеу, инспектор
+    const AttributeStore& attributes() const { return attrs; }
+    AttributeStore&       attributes()       { return attrs; }
+    std::string_view nameOf(int slot) const { return attrs.getStr(kAttrName, slot); }
+
+    // Шардтар: интеграция әр бөлікте жеке жіппен жүреді (сепарация жаһандық)
+    void setShardCount(int k) { shards.configure(*this, k); }
+    const GraphPartitioner& partition() const { return shards; }
+
+    // O(1) снапшот: кейін тек өзгерген бөліктер көшіріледі
+    GraphSnapshot snapshot() const;
+
+    // Өзгерістер журналы (дельта үшін — graph_delta.h)
+    unsigned long long version() const { return ver; }
+    const std::vector<GraphChange>& history() const { return journal; }
+    void trimHistory(unsigned long long upTo);      // ≤ upTo жазбаларын тастау
+    void setHistoryLimit(size_t n) { historyLimit = std::max<size_t>(1, n); }
 };
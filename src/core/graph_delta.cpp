@@ -0,0 +1,212 @@
+#include "graph_delta.h"
+#include "graph.h"
+#include <algorithm>
+#include <cstring>
+
+// Пішім: "BGD1", varint from, varint to, varint nOps, ops…, varint nMoves, moves…
+// id-лер zigzag varint, float-тар 4 байт (little-endian хост).
+static constexpr uint8_t kMagic[4] = { 'B', 'G', 'D', '1' };
+
+namespace {
+
+struct Writer {
+    std::vector<uint8_t>& out;
+    void u8(uint8_t v) { out.push_back(v); }
+    void varint(uint64_t v) {
+        while (v >= 0x80) { out.push_back((uint8_t)(v | 0x80)); v >>= 7; }
+        out.push_back((uint8_t)v);
+    }
+    void sint(int v) { varint(((uint64_t)(int64_t)v << 1) ^ (uint64_t)((int64_t)v >> 63)); }
+    void f32(float v) {
+        uint8_t b[4];
+        std::memcpy(b, &v, 4);
+        out.insert(out.end(), b, b + 4);
+    }
+    void vec3(const glm::vec3& v) { f32(v.x); f32(v.y); f32(v.z); }
+};
+
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok = true;
+
+    bool need(size_t n) { if ((size_t)(end - p) < n) ok = false; return ok; }
+    uint8_t u8() { return need(1) ? *p++ : 0; }
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int sh = 0; sh < 64; sh += 7) {
+            if (!need(1)) return 0;
+            uint8_t b = *p++;
+            v |= (uint64_t)(b & 0x7f) << sh;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+    int sint() {
+        uint64_t z = varint();
+        return (int)(int64_t)((z >> 1) ^ (~(z & 1) + 1));
+    }
+    float f32() {
+        float v = 0.0f;
+        if (need(4)) { std::memcpy(&v, p, 4); p += 4; }
+        return v;
+    }
+    glm::vec3 vec3() { float x = f32(), y = f32(); return glm::vec3(x, y, f32()); }
+};
+
+struct Move { int id; glm::vec3 pos; };
+
+} // namespace
+
+bool encodeDelta(const Graph& g, unsigned long long fromVer, unsigned long long toVer,
+                 std::vector<uint8_t>& out, const GraphSnapshot* posBase, float posThreshold) {
+    const auto& J = g.history();
+    if (toVer > g.version() || fromVer > toVer) return false;
+    // fromVer-ден кейінгі бірінші жазба журналда болуы керек
+    if (fromVer < toVer && (J.empty() || J.front().version > fromVer + 1)) return false;
+
+    auto first = std::upper_bound(J.begin(), J.end(), fromVer,
+        [](unsigned long long v, const GraphChange& c) { return v < c.version; });
+    auto last  = std::upper_bound(first, J.end(), toVer,
+        [](unsigned long long v, const GraphChange& c) { return v < c.version; });
+
+    out.assign(kMagic, kMagic + 4);
+    Writer w{ out };
+    w.varint(fromVer);
+    w.varint(toVer);
+    w.varint((uint64_t)(last - first));
+    for (auto it = first; it != last; ++it) {
+        const GraphChange& c = *it;
+        w.u8((uint8_t)c.op);
+        w.sint(c.id);
+        switch (c.op) {
+            case ChangeOp::AddNode:
+                w.f32(c.duration);
+                w.vec3(c.basePos);
+                w.u8((uint8_t)c.state);
+                break;
+            case ChangeOp::AddEdge:
+            case ChangeOp::RemoveEdge:
+                w.sint(c.other);
+                break;
+            case ChangeOp::State:
+                w.u8((uint8_t)c.state);
+                break;
+            case ChangeOp::StateBatch:
+                w.u8((uint8_t)c.state);
+                w.varint(c.ids.size());
+                for (int id : c.ids) w.sint(id);
+                break;
+            case ChangeOp::RemoveNode:
+                break;
+        }
+    }
+
+    // Орындар: ортақ бөліктер (өзгермеген) толық өткізіледі
+    std::vector<Move> moves;
+    if (posBase) {
+        const auto& cur  = g.getNodes();
+        const auto& base = posBase->getNodes();
+        const float thr2 = posThreshold * posThreshold;
+        const size_t C = CowVector<Node>::kChunk;
+        for (size_t c = 0; c < cur.chunkCount(); ++c) {
+            if (base.sameChunk(cur, c)) continue;
+            size_t hi = std::min(cur.size(), (c + 1) * C);
+            for (size_t i = c * C; i < hi; ++i) {
+                const Node& n = cur[i];
+                if (i < base.size() && base[i].id == n.id) {
+                    glm::vec3 d = n.pos - base[i].pos;
+                    if (glm::dot(d, d) <= thr2) continue;
+                }
+                moves.push_back({ n.id, n.pos });
+            }
+        }
+    }
+    w.varint(moves.size());
+    for (const auto& m : moves) { w.sint(m.id); w.vec3(m.pos); }
+    return true;
+}
+
+DeltaApplyResult applyDelta(Graph& g, const uint8_t* data, size_t size) {
+    using Status = DeltaApplyResult::Status;
+    DeltaApplyResult res;
+    res.status = Status::Malformed;
+    Reader r{ data, data + size };
+    if (size < 4 || std::memcmp(data, kMagic, 4) != 0) return res;
+    r.p += 4;
+    res.fromVer = r.varint();
+    res.toVer   = r.varint();
+
+    // Алдымен толық талдаймыз — бұзылған дельта графқа тимейді
+    uint64_t nOps = r.varint();
+    if (!r.ok || nOps > size || res.fromVer > res.toVer) return res;
+    std::vector<GraphChange> ops;
+    ops.reserve((size_t)nOps);
+    for (uint64_t i = 0; i < nOps && r.ok; ++i) {
+        GraphChange c;
+        uint8_t tag = r.u8();
+        if (tag > (uint8_t)ChangeOp::StateBatch) return res;
+        c.op = (ChangeOp)tag;
+        c.id = r.sint();
+        switch (c.op) {
+            case ChangeOp::AddNode:
+                c.duration = r.f32();
+                c.basePos  = r.vec3();
+                c.state    = (NodeState)(r.u8() & 3);
+                break;
+            case ChangeOp::AddEdge:
+            case ChangeOp::RemoveEdge:
+                c.other = r.sint();
+                break;
+            case ChangeOp::State:
+                c.state = (NodeState)(r.u8() & 3);
+                break;
+            case ChangeOp::StateBatch: {
+                c.state = (NodeState)(r.u8() & 3);
+                uint64_t k = r.varint();
+                if (!r.ok || k > size) return res;
+                c.ids.resize((size_t)k);
+                for (auto& id : c.ids) id = r.sint();
+                break;
+            }
+            case ChangeOp::RemoveNode:
+                break;
+        }
+        ops.push_back(std::move(c));
+    }
+    uint64_t nMoves = r.varint();
+    if (!r.ok || nMoves > size) return res;
+    std::vector<Move> moves;
+    moves.reserve((size_t)nMoves);
+    for (uint64_t i = 0; i < nMoves && r.ok; ++i) {
+        int id = r.sint();
+        moves.push_back({ id, r.vec3() });
+    }
+    if (!r.ok || r.p != r.end) return res;
+
+    // Басқа негізге қолданылған дельта тыныш «сәтті» болмауы керек
+    if (g.version() != res.fromVer) { res.status = Status::BaseMismatch; return res; }
+
+    // Әр сәтті операция журналға бір жазба қосады — нұсқалар қатар жүреді
+    for (size_t i = 0; i < ops.size(); ++i) {
+        const GraphChange& c = ops[i];
+        bool applied = false;
+        switch (c.op) {
+            case ChangeOp::AddNode:    applied = g.restoreTask(c.id, c.duration, c.basePos, c.state) >= 0; break;
+            case ChangeOp::RemoveNode: applied = g.removeTask(c.id); break;
+            case ChangeOp::AddEdge:    applied = g.addDependency(c.id, c.other) == DepStatus::Added; break;
+            case ChangeOp::RemoveEdge: applied = g.removeDependency(c.id, c.other); break;
+            case ChangeOp::State:      applied = g.setNodeState(c.id, c.state); break;
+            case ChangeOp::StateBatch: applied = g.setNodeStates(c.ids, c.state) == (int)c.ids.size(); break;
+        }
+        if (!applied) res.failedOps.push_back((int)i);
+    }
+    auto& nodes = g.getNodes();
+    for (const auto& m : moves) {
+        int s = g.slotOf(m.id);
+        if (s >= 0) nodes.mut(s).pos = m.pos;
+    }
+    res.status = res.failedOps.empty() ? Status::Ok : Status::OpsFailed;
+    return res;
+}
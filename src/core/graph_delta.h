@@ -0,0 +1,48 @@
+#pragma once
+#include "node.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class Graph;
+class GraphSnapshot;
+
+// Журнал жазбасы — әр өзгеріс өз нұсқа нөмірін алады (монотонды)
+enum class ChangeOp : uint8_t { AddNode, RemoveNode, AddEdge, RemoveEdge, State, StateBatch };
+
+struct GraphChange {
+    unsigned long long version = 0;
+    ChangeOp  op = ChangeOp::AddNode;
+    int       id = -1;           // тапсырма id (қабырғада — from)
+    int       other = -1;        // қабырғада — to
+    float     duration = 0.0f;   // AddNode
+    glm::vec3 basePos{0.0f};     // AddNode
+    NodeState state = NodeState::Neutral;
+    std::vector<int> ids;        // StateBatch: бір күйге өткен тапсырмалар
+};
+
+// Ықшам бинарлы дельта (fromVer, toVer] аралығындағы өзгерістер.
+// posBase берілсе — одан кейін posThreshold-тан көп жылжыған түйіндердің
+// орындары да қосылады (тек toVer == g.version() кезде мағыналы).
+// Журнал fromVer-ді қамтымаса false қайтарады.
+bool encodeDelta(const Graph& g, unsigned long long fromVer, unsigned long long toVer,
+                 std::vector<uint8_t>& out,
+                 const GraphSnapshot* posBase = nullptr, float posThreshold = 0.05f);
+
+struct DeltaApplyResult {
+    enum class Status : uint8_t {
+        Ok,
+        Malformed,          // пішім бұзық — граф өзгермеді
+        BaseMismatch,       // g.version() != fromVer — граф өзгермеді
+        OpsFailed,          // кейбір операция қолданылмады (failedOps) — реплика ажырады
+    };
+    Status status = Status::Ok;
+    unsigned long long fromVer = 0, toVer = 0;
+    std::vector<int> failedOps;     // дельтадағы операция индекстері
+    bool ok() const { return status == Status::Ok; }
+};
+
+// Дельтаны басқа графқа қолдану. Негіз нұсқасы (fromVer) графтың қазіргі
+// нұсқасына тең болуы керек: сәтті қолданудан кейін g.version() == toVer.
+DeltaApplyResult applyDelta(Graph& g, const uint8_t* data, size_t size);
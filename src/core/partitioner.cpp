@@ -0,0 +1,344 @@
+#include "partitioner.h"
+#include "graph.h"
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <tuple>
+#include <climits>
+#include <cmath>
+
+namespace {
+
+// Деңгей: бағытсыз салмақты CSR
+struct Level {
+    std::vector<int> xadj, adj, adjw, vwgt;
+    std::vector<int> cmap;      // → келесі (дөрекі) деңгейдегі төбе
+    int n() const { return (int)vwgt.size(); }
+};
+
+Level fromGraph(const Graph& g) {
+    const int n = g.count();
+    const auto& E = g.getEdges();
+    Level L;
+    L.vwgt.assign(n, 1);
+    L.xadj.assign(n + 1, 0);
+    for (const auto& e : E) { ++L.xadj[e.from + 1]; ++L.xadj[e.to + 1]; }
+    for (int v = 0; v < n; ++v) L.xadj[v + 1] += L.xadj[v];
+    L.adj.resize(L.xadj[n]);
+    L.adjw.assign(L.xadj[n], 1);
+    std::vector<int> fill(L.xadj.begin(), L.xadj.end() - 1);
+    for (const auto& e : E) {
+        L.adj[fill[e.from]++] = e.to;
+        L.adj[fill[e.to]++]   = e.from;
+    }
+    return L;
+}
+
+// Ауыр қабырға бойынша жұптау → дөрекі деңгей
+Level coarsen(Level& fine, std::mt19937& rng) {
+    const int n = fine.n();
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    std::vector<int> match(n, -1);
+    for (int v : order) {
+        if (match[v] >= 0) continue;
+        int best = -1, bw = -1;
+        for (int e = fine.xadj[v]; e < fine.xadj[v + 1]; ++e) {
+            int u = fine.adj[e];
+            if (u != v && match[u] < 0 && fine.adjw[e] > bw) { best = u; bw = fine.adjw[e]; }
+        }
+        match[v] = (best >= 0) ? best : v;
+        if (best >= 0) match[best] = v;
+    }
+
+    fine.cmap.assign(n, -1);
+    std::vector<int> rep;
+    rep.reserve(n);
+    for (int v = 0; v < n; ++v) {
+        if (fine.cmap[v] >= 0) continue;
+        fine.cmap[v] = fine.cmap[match[v]] = (int)rep.size();
+        rep.push_back(v);
+    }
+
+    const int nc = (int)rep.size();
+    Level C;
+    C.vwgt.assign(nc, 0);
+    C.xadj.assign(nc + 1, 0);
+    std::vector<int> where(nc, -1);
+    for (int c = 0; c < nc; ++c) {
+        int a = rep[c], b = match[a];
+        C.vwgt[c] = fine.vwgt[a] + (b != a ? fine.vwgt[b] : 0);
+        int start = (int)C.adj.size();
+        for (int v : { a, b }) {
+            for (int e = fine.xadj[v]; e < fine.xadj[v + 1]; ++e) {
+                int c2 = fine.cmap[fine.adj[e]];
+                if (c2 == c) continue;
+                if (where[c2] >= start) { C.adjw[where[c2]] += fine.adjw[e]; continue; }
+                where[c2] = (int)C.adj.size();
+                C.adj.push_back(c2);
+                C.adjw.push_back(fine.adjw[e]);
+            }
+            if (b == a) break;
+        }
+        C.xadj[c + 1] = (int)C.adj.size();
+    }
+    return C;
+}
+
+// Ашкөз өсіру (GGP): әр бөлік байланысы ең күшті төбелерді жинайды
+std::vector<int> initialPartition(const Level& L, int k, std::mt19937& rng) {
+    const int n = L.n();
+    long total = std::accumulate(L.vwgt.begin(), L.vwgt.end(), 0L);
+    std::vector<int> part(n, -1), conn(n, 0), order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    size_t seed = 0;
+
+    for (int p = 0; p < k - 1; ++p) {
+        const double target = (double)total / k;
+        long w = 0;
+        std::priority_queue<std::pair<int,int>> pq;
+        std::fill(conn.begin(), conn.end(), 0);
+        while (w < target) {
+            if (pq.empty()) {
+                while (seed < order.size() && part[order[seed]] >= 0) ++seed;
+                if (seed == order.size()) break;
+                pq.push({ 0, order[seed] });
+            }
+            int v = pq.top().second; pq.pop();
+            if (part[v] >= 0) continue;
+            part[v] = p;
+            w += L.vwgt[v];
+            for (int e = L.xadj[v]; e < L.xadj[v + 1]; ++e) {
+                int u = L.adj[e];
+                if (part[u] >= 0) continue;
+                conn[u] += L.adjw[e];
+                pq.push({ conn[u], u });
+            }
+        }
+    }
+    for (int& p : part) if (p < 0) p = k - 1;
+    return part;
+}
+
+struct Refiner {
+    const Level& L;
+    std::vector<int>& part;
+    std::vector<long>& weight;
+    int k;
+    long maxW;
+    std::vector<int> conn, touched;
+
+    Refiner(const Level& l, std::vector<int>& p, std::vector<long>& w, int k_, long mw)
+        : L(l), part(p), weight(w), k(k_), maxW(mw), conn(k_, 0) {}
+
+    // v үшін ең тиімді көшу: (gain, target) — мүмкін болмаса target = -1
+    std::pair<int,int> bestMove(int v) {
+        touched.clear();
+        for (int e = L.xadj[v]; e < L.xadj[v + 1]; ++e) {
+            int p = part[L.adj[e]];
+            if (conn[p] == 0) touched.push_back(p);
+            conn[p] += L.adjw[e];
+        }
+        int from = part[v], internal = conn[from];
+        int to = -1, best = INT_MIN;
+        for (int p : touched) {
+            if (p == from || weight[p] + L.vwgt[v] > maxW) continue;
+            if (conn[p] - internal > best) { best = conn[p] - internal; to = p; }
+        }
+        for (int p : touched) conn[p] = 0;
+        return { best, to };
+    }
+
+    void move(int v, int to) {
+        weight[part[v]] -= L.vwgt[v];
+        weight[to] += L.vwgt[v];
+        part[v] = to;
+    }
+
+    // Ауыр бөліктен жеңіліне — байланысы ең көп жерге
+    void balance() {
+        for (int v = 0; v < L.n(); ++v) {
+            int from = part[v];
+            if (weight[from] <= maxW) continue;
+            int to = (int)(std::min_element(weight.begin(), weight.end()) - weight.begin());
+            auto bm = bestMove(v);
+            if (bm.second >= 0) to = bm.second;
+            if (to != from && weight[to] + L.vwgt[v] <= maxW) move(v, to);
+        }
+    }
+
+    // FM: теріс пайдаға да рұқсат, ең жақсы префикске дейін кері қайтару
+    bool pass() {
+        const int n = L.n();
+        std::vector<char> locked(n, 0);
+        std::priority_queue<std::tuple<int,int,int>> heap;
+        for (int v = 0; v < n; ++v) {
+            auto bm = bestMove(v);
+            if (bm.second >= 0) heap.push({ bm.first, v, bm.second });
+        }
+        std::vector<std::pair<int,int>> moves;   // (v, from)
+        long cum = 0, bestCum = 0;
+        size_t bestLen = 0;
+        int sinceBest = 0;
+        const int patience = std::max(50, n / 100);
+        while (!heap.empty() && sinceBest < patience) {
+            auto [g, v, to] = heap.top(); heap.pop();
+            if (locked[v]) continue;
+            auto bm = bestMove(v);
+            if (bm.second < 0) continue;
+            if (bm.first != g || bm.second != to) { heap.push({ bm.first, v, bm.second }); continue; }
+
+            moves.push_back({ v, part[v] });
+            move(v, to);
+            locked[v] = 1;
+            cum += g;
+            if (cum > bestCum) { bestCum = cum; bestLen = moves.size(); sinceBest = 0; }
+            else ++sinceBest;
+
+            for (int e = L.xadj[v]; e < L.xadj[v + 1]; ++e) {
+                int u = L.adj[e];
+                if (locked[u]) continue;
+                auto bu = bestMove(u);
+                if (bu.second >= 0) heap.push({ bu.first, u, bu.second });
+            }
+        }
+        while (moves.size() > bestLen) {
+            move(moves.back().first, moves.back().second);
+            moves.pop_back();
+        }
+        return bestCum > 0;
+    }
+
+    void run() {
+        balance();
+        for (int i = 0; i < 8 && pass(); ++i) {}
+    }
+};
+
+} // namespace
+
+int GraphPartitioner::maxWeight(int n) const {
+    return (int)std::ceil((double)n / k * (1.0 + imbalance)) + 1;
+}
+
+void GraphPartitioner::configure(const Graph& g, int parts) {
+    k = std::max(1, parts);
+    const int n = g.count();
+    part.assign(n, 0);
+    weight.assign(k, 0);
+    pending.clear();
+    seenTopo = g.topologyVersion();
+    cut = 0;
+    if (k == 1 || n == 0) { weight[0] = n; return; }
+
+    std::mt19937 rng(12345);
+    std::vector<Level> levels;
+    levels.push_back(fromGraph(g));
+    const int stopAt = std::max(20 * k, 64);
+    while (levels.back().n() > stopAt) {
+        Level c = coarsen(levels.back(), rng);
+        if (c.n() > levels.back().n() * 9 / 10) break;    // жұптау тоқтады
+        levels.push_back(std::move(c));
+    }
+
+    std::vector<int> p = initialPartition(levels.back(), k, rng);
+    const long maxW = maxWeight(n);
+    for (int l = (int)levels.size() - 1; l >= 0; --l) {
+        const Level& L = levels[l];
+        if (l < (int)levels.size() - 1) {
+            std::vector<int> fine(L.n());
+            for (int v = 0; v < L.n(); ++v) fine[v] = p[L.cmap[v]];
+            p.swap(fine);
+        }
+        std::vector<long> w(k, 0);
+        for (int v = 0; v < L.n(); ++v) w[p[v]] += L.vwgt[v];
+        Refiner(L, p, w, k, maxW).run();
+    }
+
+    part = std::move(p);
+    for (int s = 0; s < n; ++s) ++weight[part[s]];
+    countCut(g);
+}
+
+void GraphPartitioner::onNodeAdded(const Graph& g, int slot) {
+    int light = (int)(std::min_element(weight.begin(), weight.end()) - weight.begin());
+    part.resize(slot + 1);
+    part[slot] = light;
+    ++weight[light];
+    if (k > 1) pending.push_back(g.getNodes()[slot].id);
+}
+
+void GraphPartitioner::onNodeRemoved(int slot, int last) {
+    --weight[part[slot]];
+    part[slot] = part[last];
+    part.pop_back();
+}
+
+void GraphPartitioner::placeBest(const Graph& g, int s) {
+    const auto& E = g.getEdges();
+    std::vector<int> conn(k, 0);
+    for (int e : g.outEdgesOf(s)) ++conn[part[E[e].to]];
+    for (int e : g.inEdgesOf(s))  ++conn[part[E[e].from]];
+    const int maxW = maxWeight(g.count());
+    int cur = part[s], best = cur;
+    for (int p = 0; p < k; ++p)
+        if (p != cur && weight[p] + 1 <= maxW && conn[p] > conn[best]) best = p;
+    if (best == cur) return;
+    --weight[cur];
+    ++weight[best];
+    part[s] = best;
+}
+
+void GraphPartitioner::rebalance(const Graph& g) {
+    const auto& E = g.getEdges();
+    const int maxW = maxWeight(g.count());
+    for (int guard = 0; guard < k; ++guard) {
+        int heavy = (int)(std::max_element(weight.begin(), weight.end()) - weight.begin());
+        if (weight[heavy] <= maxW) return;
+
+        // Ауыр бөліктің ең аз шығынмен кете алатын төбелері
+        std::vector<std::tuple<int,int,int>> cand;    // (gain, slot, to)
+        std::vector<int> conn(k);
+        for (int s = 0; s < g.count(); ++s) {
+            if (part[s] != heavy) continue;
+            std::fill(conn.begin(), conn.end(), 0);
+            for (int e : g.outEdgesOf(s)) ++conn[part[E[e].to]];
+            for (int e : g.inEdgesOf(s))  ++conn[part[E[e].from]];
+            int to = -1;
+            for (int p = 0; p < k; ++p)
+                if (p != heavy && weight[p] < maxW && (to < 0 || conn[p] > conn[to])) to = p;
+            if (to >= 0) cand.push_back({ conn[to] - conn[heavy], s, to });
+        }
+        std::sort(cand.begin(), cand.end(), [](const auto& a, const auto& b) { return a > b; });
+        for (const auto& [gain, s, to] : cand) {
+            if (weight[heavy] <= maxW) break;
+            if (weight[to] + 1 > maxW) continue;
+            --weight[heavy];
+            ++weight[to];
+            part[s] = to;
+        }
+    }
+}
+
+// Құрылым өзгермесе бөліну де, салмақ та өзгерген жоқ — кадр сайын O(n) өтпейміз
+void GraphPartitioner::maintain(const Graph& g) {
+    if (g.topologyVersion() == seenTopo) return;
+    seenTopo = g.topologyVersion();
+    if (k == 1) { pending.clear(); return; }
+    for (int id : pending) {
+        int s = g.slotOf(id);
+        if (s >= 0) placeBest(g, s);
+    }
+    pending.clear();
+    rebalance(g);
+    countCut(g);
+}
+
+void GraphPartitioner::countCut(const Graph& g) {
+    cut = 0;
+    for (const auto& e : g.getEdges()) cut += (part[e.from] != part[e.to]);
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+
+class Graph;
+
+// Көпдеңгейлі k-бөлікті бөлгіш: ауыр қабырға бойынша жұптау (coarsening),
+// ашкөз бастапқы бөлу (graph growing), әр деңгейде FM жетілдіру.
+// Жаңа/жойылған тапсырмалар инкременталды түрде maintain()-де орналасады.
+class GraphPartitioner {
+public:
+    void configure(const Graph& g, int k);      // толық көпдеңгейлі қайта бөлу
+
+    void onNodeAdded(const Graph& g, int slot);
+    void onNodeRemoved(int slot, int last);
+    void maintain(const Graph& g);              // құрылым өзгерсе: орналастыру + теңгеру
+
+    int parts()            const { return k; }
+    int partOf(int slot)   const { return part[slot]; }
+    int partSize(int p)    const { return weight[p]; }
+    int cutEdges()         const { return cut; }     // maintain/configure кезінде саналады
+
+    float imbalance = 0.05f;                    // рұқсат етілген артықшылық
+
+private:
+    int  maxWeight(int n) const;
+    void placeBest(const Graph& g, int slot);
+    void rebalance(const Graph& g);
+    void countCut(const Graph& g);
+
+    int k = 1;
+    std::vector<int> part;      // slot → бөлік
+    std::vector<int> weight{ 0 };   // бөлік → түйін саны
+    std::vector<int> pending;   // орналасуды күтетін тапсырма id-лері
+    int cut = 0;
+    unsigned long long seenTopo = ~0ull;    // соңғы maintain көрген құрылым нұсқасы
+};
@@ -0,0 +1,39 @@
+#include "reachability.h"
+#include "graph.h"
+#include <algorithm>
+
+void ReachSearch::nextEpoch(size_t n) const {
+    if (seen.size() < n) seen.resize(n, 0);
+    if (++epoch == 0) {
+        std::fill(seen.begin(), seen.end(), 0u);
+        epoch = 1;
+    }
+}
+
+void ReachSearch::descendants(const Graph& g, int slot, std::vector<int>& out) const {
+    const auto& E = g.getEdges();
+    out.clear();
+    nextEpoch((size_t)g.count());
+    seen[slot] = epoch;
+    out.push_back(slot);
+    for (size_t i = 0; i < out.size(); ++i)
+        for (int e : g.outEdgesOf(out[i])) {
+            int y = E[e].to;
+            if (seen[y] != epoch) { seen[y] = epoch; out.push_back(y); }
+        }
+    out.erase(out.begin());
+}
+
+void ReachSearch::ancestors(const Graph& g, int slot, std::vector<int>& out) const {
+    const auto& E = g.getEdges();
+    out.clear();
+    nextEpoch((size_t)g.count());
+    seen[slot] = epoch;
+    out.push_back(slot);
+    for (size_t i = 0; i < out.size(); ++i)
+        for (int e : g.inEdgesOf(out[i])) {
+            int y = E[e].from;
+            if (seen[y] != epoch) { seen[y] = epoch; out.push_back(y); }
+        }
+    out.erase(out.begin());
+}
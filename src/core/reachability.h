@@ -0,0 +1,21 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class Graph;
+
+// "Кім бөгелді" / "неге тәуелді" сұрақтары: epoch белгілері бар BFS.
+// Жауап — бүкіл жабылу, сондықтан индекс ұстамаймыз: құрылым
+// өзгергенде жаңартатын ештеңе жоқ.
+class ReachSearch {
+public:
+    void descendants(const Graph& g, int slot, std::vector<int>& out) const;
+    void ancestors(const Graph& g, int slot, std::vector<int>& out) const;
+
+private:
+    void nextEpoch(size_t n) const;
+
+    mutable std::vector<uint32_t> seen;    // BFS белгілері (epoch)
+    mutable uint32_t epoch = 0;
+};
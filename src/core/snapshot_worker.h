@@ -0,0 +1,73 @@
+#pragma once
+#include "graph.h"
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// Фондық талдау ағыны: топология өзгергенде снапшот алады, fn арқылы
+// есептейді, нәтижені жариялайды. fn алдыңғы нәтижені алады (жылы старт).
+template <class Result>
+class SnapshotWorker {
+public:
+    using Fn = std::function<std::shared_ptr<Result>(const GraphSnapshot&, const std::shared_ptr<const Result>&)>;
+
+    explicit SnapshotWorker(Fn f) : fn(std::move(f)), th([this] { loop(); }) {}
+    ~SnapshotWorker() {
+        {
+            std::lock_guard<std::mutex> lk(mx);
+            quit = true;
+        }
+        cv.notify_all();
+        th.join();
+    }
+
+    // Бос болса және топология өзгерсе (немесе force) — жаңа есеп
+    void request(const Graph& g, bool force = false) {
+        if (running.load() || (!force && g.topologyVersion() == requestedVer)) return;
+        requestedVer = g.topologyVersion();
+        running = true;
+        {
+            std::lock_guard<std::mutex> lk(mx);
+            job = std::make_unique<GraphSnapshot>(g.snapshot());
+        }
+        cv.notify_one();
+    }
+
+    std::shared_ptr<const Result> latest() const {
+        std::lock_guard<std::mutex> lk(mx);
+        return result;
+    }
+    bool busy() const { return running.load(); }
+
+private:
+    void loop() {
+        for (;;) {
+            std::unique_ptr<GraphSnapshot> snap;
+            {
+                std::unique_lock<std::mutex> lk(mx);
+                cv.wait(lk, [&] { return quit || job; });
+                if (quit) return;
+                snap = std::move(job);
+            }
+            std::shared_ptr<const Result> res = fn(*snap, latest());
+            {
+                std::lock_guard<std::mutex> lk(mx);
+                result = std::move(res);
+            }
+            running = false;
+        }
+    }
+
+    Fn fn;
+    mutable std::mutex mx;
+    std::condition_variable cv;
+    std::unique_ptr<GraphSnapshot> job;
+    std::shared_ptr<const Result> result;
+    std::atomic<bool> running{ false };
+    bool quit = false;
+    unsigned long long requestedVer = ~0ull;
+    std::thread th;                     // соңғы — қалғандары дайын болғаннан кейін іске қосылады
+};
@@ -0,0 +1,92 @@
+#include "state_index.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static inline int popcount64(uint64_t x) {
+#ifdef _MSC_VER
+    return (int)__popcnt64(x);
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+void StateIndex::setPacked(int slot, NodeState s) {
+    uint64_t& w = packed[slot >> 5];
+    int sh = (slot & 31) * 2;
+    w = (w & ~(uint64_t(3) << sh)) | (uint64_t(s) << sh);
+}
+
+void StateIndex::link(int slot, NodeState s) {
+    int h = heads[(int)s];
+    prevOf[slot] = -1;
+    nextOf[slot] = h;
+    if (h >= 0) prevOf[h] = slot;
+    heads[(int)s] = slot;
+    ++counts[(int)s];
+}
+
+void StateIndex::unlink(int slot, NodeState s) {
+    int p = prevOf[slot], n = nextOf[slot];
+    if (p >= 0) nextOf[p] = n; else heads[(int)s] = n;
+    if (n >= 0) prevOf[n] = p;
+    --counts[(int)s];
+}
+
+void StateIndex::onNodeAdded(int slot, NodeState s) {
+    size = slot + 1;
+    prevOf.resize(size);
+    nextOf.resize(size);
+    packed.resize((size + 31) >> 5, 0);
+    setPacked(slot, s);
+    link(slot, s);
+}
+
+void StateIndex::onStateChanged(int slot, NodeState s) {
+    NodeState old = stateAt(slot);
+    if (old == s) return;
+    unlink(slot, old);
+    link(slot, s);
+    setPacked(slot, s);
+}
+
+void StateIndex::onNodeRemoved(int slot, int last) {
+    unlink(slot, stateAt(slot));
+    if (slot != last) {
+        // last → slot: көршілер жаңа slot-қа бағытталады
+        NodeState ls = stateAt(last);
+        int p = prevOf[last], n = nextOf[last];
+        if (p >= 0) nextOf[p] = slot; else heads[(int)ls] = slot;
+        if (n >= 0) prevOf[n] = slot;
+        prevOf[slot] = p;
+        nextOf[slot] = n;
+        setPacked(slot, ls);
+    }
+    setPacked(last, NodeState::Neutral);
+    size = last;
+    prevOf.resize(size);
+    nextOf.resize(size);
+    packed.resize((size + 31) >> 5);
+}
+
+int StateIndex::countInRange(NodeState s, int lo, int hi) const {
+    if (lo < 0) lo = 0;
+    if (hi > size) hi = size;
+    if (lo >= hi) return 0;
+
+    // Әр 2-биттік өріс s-ке тең болса, төменгі битінде 1 қалады
+    const uint64_t lowBits = 0x5555555555555555ull;
+    const uint64_t pat = lowBits * (uint64_t)s;
+    int total = 0;
+    for (int w = lo >> 5; w <= (hi - 1) >> 5; ++w) {
+        uint64_t x = packed[w] ^ pat;
+        uint64_t m = ~(x | (x >> 1)) & lowBits;
+        int a = std::max(lo - (w << 5), 0);
+        int b = std::min(hi - (w << 5), 32);
+        if (b < 32) m &= (uint64_t(1) << (b * 2)) - 1;
+        if (a > 0)  m &= ~((uint64_t(1) << (a * 2)) - 1);
+        total += popcount64(m);
+    }
+    return total;
+}
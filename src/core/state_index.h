@@ -0,0 +1,38 @@
+#pragma once
+#include "node.h"
+#include <vector>
+#include <cstdint>
+
+// Күй бойынша индекс: O(1) санауыштар, әр күйге интрузивті тізім
+// (prev/next slot-тар) және 2-биттік қысылған күй векторы.
+class StateIndex {
+public:
+    static constexpr int kStates = 4;
+
+    void onNodeAdded(int slot, NodeState s);
+    void onStateChanged(int slot, NodeState s);
+    void onNodeRemoved(int slot, int last);      // swap-remove алдында
+
+    int count(NodeState s) const { return counts[(int)s]; }
+    NodeState stateAt(int slot) const {
+        return (NodeState)((packed[slot >> 5] >> ((slot & 31) * 2)) & 3u);
+    }
+
+    // Тізім бойынша жүру: for (s = first(st); s >= 0; s = next(s))
+    int first(NodeState s) const { return heads[(int)s]; }
+    int next(int slot)     const { return nextOf[slot]; }
+
+    // [lo, hi) аралығындағы st күйіндегі slot саны (popcount)
+    int countInRange(NodeState s, int lo, int hi) const;
+
+private:
+    void link(int slot, NodeState s);
+    void unlink(int slot, NodeState s);
+    void setPacked(int slot, NodeState s);
+
+    int counts[kStates] = { 0, 0, 0, 0 };
+    int heads[kStates]  = { -1, -1, -1, -1 };
+    std::vector<int> prevOf, nextOf;
+    std::vector<uint64_t> packed;   // бір сөзде 32 күй
+    int size = 0;
+};
@@ -0,0 +1,78 @@
+#include "task_groups.h"
+
+int TaskGroups::create(int parent) {
+    TaskGroup g;
+    g.parent = parent;
+    g.level  = (parent >= 0) ? groups[parent].level + 1 : 0;
+    groups.push_back(g);
+    return (int)groups.size() - 1;
+}
+
+void TaskGroups::add(int group, NodeState st, const glm::vec3& basePos, int sign) {
+    for (int g = group; g >= 0; g = groups[g].parent) {
+        groups[g].counts[(int)st] += sign;
+        groups[g].total   += sign;
+        groups[g].baseSum += basePos * (float)sign;
+    }
+}
+
+void TaskGroups::assign(int slot, int group, NodeState st, const glm::vec3& basePos) {
+    int old = slotGroup[slot];
+    if (old == group) return;
+    if (old >= 0)   add(old, st, basePos, -1);
+    if (group >= 0) add(group, st, basePos, +1);
+    slotGroup[slot] = group;
+}
+
+void TaskGroups::onNodeAdded(int slot) {
+    slotGroup.resize(slot + 1, -1);
+}
+
+void TaskGroups::onBaseMoved(int slot, const glm::vec3& from, const glm::vec3& to) {
+    for (int g = slotGroup[slot]; g >= 0; g = groups[g].parent) groups[g].baseSum += to - from;
+}
+
+void TaskGroups::onStateChanged(int slot, NodeState from, NodeState to) {
+    if (from == to) return;
+    for (int g = slotGroup[slot]; g >= 0; g = groups[g].parent) {
+        --groups[g].counts[(int)from];
+        ++groups[g].counts[(int)to];
+    }
+}
+
+void TaskGroups::onStatesChanged(const std::vector<int>& slots, const std::vector<NodeState>& from, NodeState to) {
+    pending.resize(groups.size(), std::array<int, 4>{});
+    touched.clear();
+    for (size_t i = 0; i < slots.size(); ++i) {
+        const int g = slotGroup[slots[i]];
+        if (g < 0 || from[i] == to) continue;
+        auto& d = pending[g];
+        if (d == std::array<int, 4>{}) touched.push_back(g);
+        --d[(int)from[i]];
+        ++d[(int)to];
+    }
+    for (int leaf : touched) {
+        auto& d = pending[leaf];
+        for (int g = leaf; g >= 0; g = groups[g].parent)
+            for (int s = 0; s < 4; ++s) groups[g].counts[s] += d[s];
+        d = {};
+    }
+}
+
+void TaskGroups::onNodeRemoved(int slot, int last, NodeState st, const glm::vec3& basePos) {
+    if (slotGroup[slot] >= 0) add(slotGroup[slot], st, basePos, -1);
+    slotGroup[slot] = slotGroup[last];
+    slotGroup.pop_back();
+}
+
+int TaskGroups::topCollapsed(int group) const {
+    int top = -1;
+    for (int g = group; g >= 0; g = groups[g].parent)
+        if (groups[g].collapsed) top = g;
+    return top;
+}
+
+bool TaskGroups::isProxy(int group) const {
+    const TaskGroup& g = groups[group];
+    return g.collapsed && g.total > 0 && (g.parent < 0 || topCollapsed(g.parent) < 0);
+}
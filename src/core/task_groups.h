@@ -0,0 +1,51 @@
+#pragma once
+#include "node.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <array>
+
+// Иерархиялық топ: job (level 0) → stage (level 1) → task
+struct TaskGroup {
+    int parent = -1;
+    int level  = 0;
+    int counts[4] = { 0, 0, 0, 0 };   // NodeState бойынша агрегат
+    int total  = 0;
+    glm::vec3 baseSum{0.0f};          // proxy орны = baseSum / total
+    bool collapsed = false;
+    bool pinned    = false;           // басу арқылы ашық ұсталады
+};
+
+// Топтар мен агрегаттар — әр өзгеріс тек аталар тізбегін (≤2 деңгей) жаңартады
+class TaskGroups {
+public:
+    int  create(int parent);
+    void assign(int slot, int group, NodeState st, const glm::vec3& basePos);
+
+    // Graph хуктары
+    void onNodeAdded(int slot);
+    void onStateChanged(int slot, NodeState from, NodeState to);
+    // Топтық: from[i] → to; әр жапырақ топ үшін ата-тізбек бір рет өтіледі
+    void onStatesChanged(const std::vector<int>& slots, const std::vector<NodeState>& from, NodeState to);
+    void onNodeRemoved(int slot, int last, NodeState st, const glm::vec3& basePos);
+    void onBaseMoved(int slot, const glm::vec3& from, const glm::vec3& to);
+
+    int  groupOf(int slot) const { return slotGroup[slot]; }
+    bool hidden(int slot) const { return topCollapsed(slotGroup[slot]) >= 0; }
+    int  topCollapsed(int group) const;            // ең сыртқы жабық ата (-1 жоқ)
+    bool isProxy(int group) const;                 // жеке сфера ретінде сызылады
+
+    int  size() const { return (int)groups.size(); }
+    const TaskGroup& operator[](int g) const { return groups[g]; }
+    TaskGroup&       operator[](int g)       { return groups[g]; }
+    glm::vec3 centroid(int g) const {
+        return groups[g].total ? groups[g].baseSum / (float)groups[g].total : glm::vec3(0.0f);
+    }
+
+private:
+    void add(int group, NodeState st, const glm::vec3& basePos, int sign);
+
+    std::vector<TaskGroup> groups;
+    std::vector<int> slotGroup;   // slot → stage (немесе job) id
+    std::vector<std::array<int, 4>> pending;   // onStatesChanged: топ → күй айырмасы
+    std::vector<int> touched;
+};
@@ -0,0 +1,87 @@
+#include "topo_order.h"
+#include "graph.h"
+#include <algorithm>
+
+void TopoOrder::onNodeAdded(int slot) {
+    ord.resize(slot + 1);
+    ord[slot] = nextOrd++;          // жаңа түйін — ең соңында
+}
+
+void TopoOrder::onNodeRemoved(int slot, int last) {
+    ord[slot] = ord[last];          // қалғандардың салыстырмалы реті өзгермейді
+    ord.pop_back();
+}
+
+void TopoOrder::nextEpoch(size_t n) {
+    if (seen.size() < n) seen.resize(n, 0);
+    if (++epoch == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        epoch = 1;
+    }
+}
+
+bool TopoOrder::tryAddEdge(const Graph& g, int from, int to) {
+    const int64_t lb = ord[to], ub = ord[from];
+    if (lb > ub) return true;                   // рет бұзылмайды
+    if (from == to) return false;
+
+    nextEpoch(ord.size());
+    if (!forward(g, to, ub, from)) return false;
+    backward(g, from, lb);
+    reorder();
+    return true;
+}
+
+// to-дан ord ≤ ub аймағында алға; target-ке жетсе — цикл
+bool TopoOrder::forward(const Graph& g, int start, int64_t ub, int target) {
+    const auto& E = g.getEdges();
+    deltaF.clear();
+    stack.assign(1, start);
+    seen[start] = epoch;
+    while (!stack.empty()) {
+        int s = stack.back(); stack.pop_back();
+        deltaF.push_back(s);
+        for (int e : g.outEdgesOf(s)) {
+            int t = E[e].to;
+            if (t == target) return false;
+            if (seen[t] == epoch || ord[t] > ub) continue;
+            seen[t] = epoch;
+            stack.push_back(t);
+        }
+    }
+    return true;
+}
+
+// from-нан ord ≥ lb аймағында кері
+void TopoOrder::backward(const Graph& g, int start, int64_t lb) {
+    const auto& E = g.getEdges();
+    deltaB.clear();
+    stack.assign(1, start);
+    seen[start] = epoch;
+    while (!stack.empty()) {
+        int s = stack.back(); stack.pop_back();
+        deltaB.push_back(s);
+        for (int e : g.inEdgesOf(s)) {
+            int f = E[e].from;
+            if (seen[f] == epoch || ord[f] < lb) continue;
+            seen[f] = epoch;
+            stack.push_back(f);
+        }
+    }
+}
+
+// deltaB (аталар) бірінші, содан кейін deltaF — бұрынғы рет мәндерін қайта үлестіреміз
+void TopoOrder::reorder() {
+    auto byOrd = [&](int a, int b) { return ord[a] < ord[b]; };
+    std::sort(deltaB.begin(), deltaB.end(), byOrd);
+    std::sort(deltaF.begin(), deltaF.end(), byOrd);
+
+    pool.clear();
+    for (int s : deltaB) pool.push_back(ord[s]);
+    for (int s : deltaF) pool.push_back(ord[s]);
+    std::sort(pool.begin(), pool.end());
+
+    size_t i = 0;
+    for (int s : deltaB) ord[s] = pool[i++];
+    for (int s : deltaF) ord[s] = pool[i++];
+}
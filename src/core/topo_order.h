@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class Graph;
+
+// Инкременталды топологиялық рет (Pearce–Kelly).
+// ord[from] < ord[to] болса қабырға бірден қабылданады; әйтпесе тек
+// [ord[to], ord[from]] аралығындағы аймақ қаралады: алға іздеу from-ға
+// жетсе — цикл (қабырға қабылданбайды), болмаса сол аймақ қайта реттеледі.
+class TopoOrder {
+public:
+    void onNodeAdded(int slot);
+    void onNodeRemoved(int slot, int last);       // swap-remove алдында
+
+    // Қабырға қосылмас бұрын шақырылады; false — цикл пайда болар еді
+    bool tryAddEdge(const Graph& g, int from, int to);
+
+    int64_t order(int slot) const { return ord[slot]; }
+
+private:
+    bool forward(const Graph& g, int start, int64_t ub, int target);
+    void backward(const Graph& g, int start, int64_t lb);
+    void reorder();
+    void nextEpoch(size_t n);
+
+    std::vector<int64_t> ord;       // slot → рет (бірегей, тесіктер болуы мүмкін)
+    int64_t nextOrd = 0;
+
+    std::vector<uint32_t> seen;     // DFS белгілері (epoch)
+    uint32_t epoch = 0;
+    std::vector<int> stack, deltaF, deltaB;
+    std::vector<int64_t> pool;
+};
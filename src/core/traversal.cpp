@@ -0,0 +1,192 @@
+#include "traversal.h"
+#include "graph.h"
+#include "../utils/parallel.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+inline int ctz64(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return (int)i;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+constexpr long long kAlpha = 14;        // mf > mu/α → bottom-up
+constexpr long long kBeta  = 24;        // nf < n/β → қайтадан top-down
+constexpr long long kGrain = 1 << 14;   // бір жұмыс бөлігіндегі қабырға саны
+constexpr int kBlockWords  = 64;        // bottom-up бөлігі: 64 сөз = 4096 төбе
+
+void buildCsr(const Graph& g, Csr& c, bool out) {
+    const int n = g.count();
+    const auto& E = g.getEdges();
+    c.offs.resize(n + 1);
+    c.offs[0] = 0;
+    for (int v = 0; v < n; ++v)
+        c.offs[v + 1] = c.offs[v] + (int)(out ? g.outEdgesOf(v) : g.inEdgesOf(v)).size();
+    c.adj.resize(c.offs[n]);
+    const int chunks = std::max(1, (int)(c.adj.size() / kGrain));
+    parallelFor(chunks, [&](int ch) {
+        int lo = (int)((long long)n * ch / chunks), hi = (int)((long long)n * (ch + 1) / chunks);
+        for (int v = lo; v < hi; ++v) {
+            int k = c.offs[v];
+            if (out) for (int e : g.outEdgesOf(v)) c.adj[k++] = E[e].to;
+            else     for (int e : g.inEdgesOf(v))  c.adj[k++] = E[e].from;
+        }
+    });
+}
+} // namespace
+
+void buildCsr(const CowVector<Edge>& edges, int n, Csr& out, Csr& in) {
+    out.offs.assign(n + 1, 0);
+    in.offs.assign(n + 1, 0);
+    for (const auto& e : edges) { ++out.offs[e.from + 1]; ++in.offs[e.to + 1]; }
+    for (int v = 0; v < n; ++v) { out.offs[v + 1] += out.offs[v]; in.offs[v + 1] += in.offs[v]; }
+    out.adj.resize(edges.size());
+    in.adj.resize(edges.size());
+    std::vector<int> fo(out.offs.begin(), out.offs.end() - 1), fi(in.offs.begin(), in.offs.end() - 1);
+    for (const auto& e : edges) {
+        out.adj[fo[e.from]++] = e.to;
+        in.adj[fi[e.to]++]    = e.from;
+    }
+}
+
+void TraversalEngine::sync(const Graph& g) {
+    if (builtFor == g.topologyVersion() && fwd.n() == g.count()) return;
+    buildCsr(g, fwd, true);
+    buildCsr(g, bwd, false);
+    builtFor = g.topologyVersion();
+}
+
+void TraversalEngine::assign(Csr out, Csr in) {
+    fwd = std::move(out);
+    bwd = std::move(in);
+    builtFor = ~0ull;
+}
+
+long long TraversalEngine::frontierEdges(const Csr& a, const Csr* b) const {
+    long long m = 0;
+    for (int v : frontier) m += a.degree(v) + (b ? b->degree(v) : 0);
+    return m;
+}
+
+void TraversalEngine::bfs(const std::vector<int>& sources, Dir dir, int maxDepth, std::vector<int>& out) {
+    out.clear();
+    st = {};
+    const int n = fwd.n();
+    if (n <= 0) return;
+
+    const size_t words = ((size_t)n + 63) / 64;
+    if (vis.size() != words) vis = std::vector<std::atomic<uint64_t>>(words);
+    for (auto& w : vis) w.store(0, std::memory_order_relaxed);
+
+    // Top-down a бойынша кеңейеді; bottom-up a-ның кері жағын тексереді
+    const Csr& a = (dir == Dir::Up) ? bwd : fwd;
+    const Csr* b = (dir == Dir::Both) ? &bwd : nullptr;
+
+    frontier.clear();
+    for (int s : sources) {
+        if (s < 0 || s >= n) continue;
+        uint64_t bit = 1ull << (s & 63);
+        if (vis[s >> 6].load(std::memory_order_relaxed) & bit) continue;
+        vis[s >> 6].fetch_or(bit, std::memory_order_relaxed);
+        frontier.push_back(s);
+    }
+    out = frontier;
+
+    long long unexplored = (long long)a.adj.size() + (b ? (long long)b->adj.size() : 0);
+    bool bottomUp = false;
+    for (int depth = 0; !frontier.empty() && (maxDepth < 0 || depth < maxDepth); ++depth) {
+        long long mf = frontierEdges(a, b);
+        unexplored -= mf;
+        if (!bottomUp && mf > unexplored / kAlpha)                      bottomUp = true;
+        else if (bottomUp && (long long)frontier.size() < n / kBeta)   bottomUp = false;
+
+        if (bottomUp) { stepBottomUp(a, b);    ++st.bottomUp; }
+        else          { stepTopDown(a, b, mf); ++st.topDown; st.edgesScanned += mf; }
+        ++st.levels;
+        out.insert(out.end(), frontier.begin(), frontier.end());
+    }
+}
+
+// Фронтир тізімін бөліктерге бөліп, көршілерді atomic fetch_or арқылы белгілейміз
+void TraversalEngine::stepTopDown(const Csr& a, const Csr* b, long long mf) {
+    int chunks = parallel ? (int)std::min<long long>((long long)workerCount() * 4, mf / kGrain + 1) : 1;
+    chunks = std::max(1, std::min(chunks, (int)frontier.size()));
+    parts.resize(chunks);
+
+    auto visit = [&](const Csr& c, int u, std::vector<int>& local) {
+        for (int k = c.offs[u]; k < c.offs[u + 1]; ++k) {
+            int v = c.adj[k];
+            uint64_t bit = 1ull << (v & 63);
+            auto& w = vis[v >> 6];
+            if (w.load(std::memory_order_relaxed) & bit) continue;
+            if (!(w.fetch_or(bit, std::memory_order_relaxed) & bit)) local.push_back(v);
+        }
+    };
+    auto run = [&](int ch) {
+        auto& local = parts[ch];
+        local.clear();
+        size_t lo = frontier.size() * ch / chunks, hi = frontier.size() * (ch + 1) / chunks;
+        for (size_t i = lo; i < hi; ++i) {
+            visit(a, frontier[i], local);
+            if (b) visit(*b, frontier[i], local);
+        }
+    };
+    if (chunks == 1) run(0);
+    else parallelFor(chunks, run);
+
+    frontier.clear();
+    for (auto& p : parts) frontier.insert(frontier.end(), p.begin(), p.end());
+}
+
+// Әр барылмаған төбе үшін: фронтирде ата бар ма? Әр бөлік өз сөздеріне ғана жазады
+void TraversalEngine::stepBottomUp(const Csr& a, const Csr* b) {
+    const int n = a.n();
+    const size_t words = vis.size();
+    front.assign(words, 0);
+    for (int v : frontier) front[v >> 6] |= 1ull << (v & 63);
+
+    // a бойынша кеңейту = кері CSR-да фронтирдегі атаны іздеу (Both — екеуінде де)
+    const Csr& rev = (&a == &fwd) ? bwd : fwd;
+    auto inFront = [&](const Csr& c, int v) {
+        for (int k = c.offs[v]; k < c.offs[v + 1]; ++k) {
+            int p = c.adj[k];
+            if (front[p >> 6] & (1ull << (p & 63))) return true;
+        }
+        return false;
+    };
+
+    const int chunks = (int)((words + kBlockWords - 1) / kBlockWords);
+    parts.resize(chunks);
+    auto run = [&](int ch) {
+        auto& local = parts[ch];
+        local.clear();
+        size_t w1 = std::min(words, (size_t)(ch + 1) * kBlockWords);
+        for (size_t w = (size_t)ch * kBlockWords; w < w1; ++w) {
+            uint64_t todo = ~vis[w].load(std::memory_order_relaxed);
+            if (w == words - 1 && (n & 63)) todo &= (1ull << (n & 63)) - 1;
+            uint64_t found = 0;
+            while (todo) {
+                int bitIdx = ctz64(todo);
+                todo &= todo - 1;
+                int v = (int)(w * 64) + bitIdx;
+                if (inFront(rev, v) || (b && inFront(a, v))) {
+                    found |= 1ull << bitIdx;
+                    local.push_back(v);
+                }
+            }
+            if (found) vis[w].fetch_or(found, std::memory_order_relaxed);
+        }
+    };
+    if (!parallel || chunks == 1) for (int ch = 0; ch < chunks; ++ch) run(ch);
+    else parallelFor(chunks, run);
+
+    frontier.clear();
+    for (auto& p : parts) frontier.insert(frontier.end(), p.begin(), p.end());
+}
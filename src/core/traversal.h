@@ -0,0 +1,56 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "edge.h"
+#include "cow_vector.h"
+
+class Graph;
+
+// Сығылған іргелестік (CSR): offs[v]..offs[v+1] — v-ның көршілері
+struct Csr {
+    std::vector<int> offs{ 0 };
+    std::vector<int> adj;
+    int n() const { return (int)offs.size() - 1; }
+    int degree(int v) const { return offs[v + 1] - offs[v]; }
+};
+
+// Қабырғалар тізімінен (мысалы снапшоттан) шығыс/кіріс CSR құру
+void buildCsr(const CowVector<Edge>& edges, int n, Csr& out, Csr& in);
+
+// Параллель, бағытты оңтайлайтын BFS (Beamer): фронтир аз болса top-down
+// (тізім, atomic белгілеу), үлкейсе bottom-up (битмап фронтир, әр жіп өз
+// сөздеріне жазады). CSR Graph-тан topologyVersion өзгергенде ғана қайта құрылады.
+class TraversalEngine {
+public:
+    enum class Dir : uint8_t { Down, Up, Both };    // ұрпақтар / аталар / бағытсыз
+
+    struct Stats {
+        int levels = 0, topDown = 0, bottomUp = 0;
+        long long edgesScanned = 0;
+    };
+
+    void sync(const Graph& g);
+    void assign(Csr out, Csr in);                   // сыртқы CSR (бенчмарк, снапшот)
+
+    // sources-тан maxDepth қадамға дейін (< 0 — шектеусіз); нәтиже көздерді қосады
+    void bfs(const std::vector<int>& sources, Dir dir, int maxDepth, std::vector<int>& out);
+
+    const Stats& stats() const { return st; }
+    bool parallel = true;
+
+private:
+    void stepTopDown(const Csr& a, const Csr* b, long long mf);
+    void stepBottomUp(const Csr& a, const Csr* b);
+    long long frontierEdges(const Csr& a, const Csr* b) const;
+
+    Csr fwd, bwd;                                   // шығыс / кіріс
+    unsigned long long builtFor = ~0ull;
+
+    std::vector<std::atomic<uint64_t>> vis;         // барылғандар
+    std::vector<uint64_t> front;                    // bottom-up үшін фронтир битмапы
+    std::vector<int> frontier;
+    std::vector<std::vector<int>> parts;            // бөлік сайынғы келесі фронтир
+    Stats st;
+};
@@ -0,0 +1,245 @@
+#include "headless.h"
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "core/graph.h"
+#include "renderer/graph_renderer.h"
+#include "utils/camera.h"
+#include "utils/frame_profiler.h"
+#include "utils/gpu_timer.h"
+#include "utils/startup_timeline.h"
+
+namespace {
+
+struct EglContext {
+    EGLDisplay dpy = EGL_NO_DISPLAY;
+    EGLContext ctx = EGL_NO_CONTEXT;
+    EGLSurface surf = EGL_NO_SURFACE;
+
+    ~EglContext() {
+        if (dpy == EGL_NO_DISPLAY) return;
+        eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (surf != EGL_NO_SURFACE) eglDestroySurface(dpy, surf);
+        if (ctx != EGL_NO_CONTEXT)  eglDestroyContext(dpy, ctx);
+        eglTerminate(dpy);
+    }
+
+    // Mesa-да алдымен surfaceless платформа (дисплей сервері керек емес),
+    // болмаса әдепкі дисплей. Кеңейту болса — бетсіз, әйтпесе 1×1 pbuffer:
+    // нақты сызу бәрібір FBO-ға.
+    bool create() {
+        auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay) dpy = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (dpy == EGL_NO_DISPLAY) dpy = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        EGLint major = 0, minor = 0;
+        if (dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, &major, &minor)) {
+            std::fprintf(stderr, "EGL: no display\n");
+            dpy = EGL_NO_DISPLAY;
+            return false;
+        }
+        if (!eglBindAPI(EGL_OPENGL_API)) {
+            std::fprintf(stderr, "EGL: desktop OpenGL API unavailable\n");
+            return false;
+        }
+
+        const char* ext = eglQueryString(dpy, EGL_EXTENSIONS);
+        const bool surfaceless = ext && std::strstr(ext, "EGL_KHR_surfaceless_context");
+        const EGLint cfgAttr[] = {
+            EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+            EGL_NONE
+        };
+        EGLConfig cfg;
+        EGLint count = 0;
+        if (!eglChooseConfig(dpy, cfgAttr, &cfg, 1, &count) || count == 0) {
+            std::fprintf(stderr, "EGL: no OpenGL config\n");
+            return false;
+        }
+        const EGLint ctxAttr[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        ctx = eglCreateContext(dpy, cfg, EGL_NO_CONTEXT, ctxAttr);
+        if (ctx == EGL_NO_CONTEXT) {
+            std::fprintf(stderr, "EGL: cannot create a 3.3 core context\n");
+            return false;
+        }
+        if (!surfaceless) {
+            const EGLint pbAttr[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+            surf = eglCreatePbufferSurface(dpy, cfg, pbAttr);
+        }
+        if (!eglMakeCurrent(dpy, surf, surf, ctx)) {
+            std::fprintf(stderr, "EGL: make current failed\n");
+            return false;
+        }
+        std::printf("EGL %d.%d, %s\n", major, minor, surfaceless ? "surfaceless" : "pbuffer");
+        return true;
+    }
+};
+
+// Түс + тереңдік renderbuffer-лері бар FBO
+struct OffscreenTarget {
+    unsigned fbo = 0, color = 0, depth = 0;
+
+    bool create(int w, int h) {
+        glGenFramebuffers(1, &fbo);
+        glGenRenderbuffers(1, &color);
+        glGenRenderbuffers(1, &depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, color);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+        glBindRenderbuffer(GL_RENDERBUFFER, depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+        return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    }
+    ~OffscreenTarget() {
+        if (fbo)   glDeleteFramebuffers(1, &fbo);
+        if (color) glDeleteRenderbuffers(1, &color);
+        if (depth) glDeleteRenderbuffers(1, &depth);
+    }
+};
+
+// Бинарлы PPM (P6); GL жолдары төменнен жоғары — аударып жазамыз
+bool writePpm(const std::string& path, int w, int h) {
+    std::vector<unsigned char> px((size_t)w * h * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, px.data());
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", w, h);
+    for (int y = h - 1; y >= 0; --y) std::fwrite(&px[(size_t)y * w * 3], 1, (size_t)w * 3, f);
+    std::fclose(f);
+    return true;
+}
+
+// Сценарийлі камера: t ∈ [0,1) бойы бір толық айналым, ортасында жақындайды
+// (LOD мен culling екі шетінде де жұмыс істесін)
+void scriptCamera(Camera3D& cam, float t, float worldR) {
+    const float kTau = 6.2831853f;
+    cam.target   = glm::vec3(0.0f);
+    cam.yaw      = 0.7f + kTau * t;
+    cam.pitch    = -0.35f + 0.25f * std::sin(kTau * t);
+    cam.distance = worldR * (2.8f - 1.6f * std::sin(0.5f * kTau * t));
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t i = (size_t)std::min<double>(sorted.size() - 1, std::floor(p * (sorted.size() - 1) + 0.5));
+    return sorted[i];
+}
+
+} // namespace
+
+int runHeadless(const HeadlessOptions& opt) {
+    StartupTimeline startup;
+    EglContext egl;
+    if (!egl.create()) return 1;
+    if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        std::fprintf(stderr, "Failed to initialize GLAD\n");
+        return 1;
+    }
+    std::printf("GL: %s | %s\n", (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION));
+    startup.mark("EGL context");
+
+    const int w = opt.width, h = opt.height;
+    OffscreenTarget target;
+    if (!target.create(w, h)) {
+        std::fprintf(stderr, "Offscreen framebuffer incomplete\n");
+        return 1;
+    }
+    if (!opt.ppmDir.empty()) std::filesystem::create_directories(opt.ppmDir);
+
+    Graph graph(opt.nodes);
+    GraphRenderer renderer;
+    Camera3D cam;
+    FrameProfiler prof;
+    GpuTimer gpuTimer;
+    const float worldR = std::max(1.2f, 0.28f * std::cbrt((float)std::max(1, opt.nodes)));
+
+    renderer.shaderManager().setTimeline(&startup);
+    startup.mark("graph");
+
+    RenderOptions ro;
+    ro.profiler = &prof;
+    ro.gpuTimer = &gpuTimer;
+    ro.impostors = opt.impostors;
+    ro.multiDraw = opt.multiDraw;
+
+    std::vector<double> frameMs;
+    frameMs.reserve(opt.frames);
+    const int total = opt.warmup + opt.frames;
+    for (int f = 0; f < total; ++f) {
+        const int k = f - opt.warmup;                       // < 0 — қыздыру
+        scriptCamera(cam, k < 0 ? 0.0f : (float)k / (float)opt.frames, worldR);
+
+        auto t0 = std::chrono::steady_clock::now();
+        {
+            FrameProfiler::Scope t(&prof, "update");
+            graph.update(1.0f / 60.0f);                     // тұрақты қадам — қайталанатын нәтиже
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+        glViewport(0, 0, w, h);
+        glEnable(GL_DEPTH_TEST);
+        glClearColor(0.07f, 0.08f, 0.10f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        gpuTimer.beginFrame();
+        renderer.render(graph, cam, w, h, -1, ro);
+        glFinish();                                         // кадр уақыты GPU жұмысын да қамтысын
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (f == 0) startup.mark("first frame");
+        if (k < 0) continue;
+        if (k == 0) {
+            // Бірінші кадрдағы шейдер компиляциясы орташаны бұзбасын
+            prof.reset();
+            gpuTimer.resetStats();
+        }
+        frameMs.push_back(ms);
+
+        const bool last = k == opt.frames - 1;
+        if (!opt.ppmDir.empty() && (last || (opt.ppmEvery > 0 && k % opt.ppmEvery == 0))) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "/frame_%05d.ppm", k);
+            if (!writePpm(opt.ppmDir + name, w, h)) std::fprintf(stderr, "Cannot write %s%s\n", opt.ppmDir.c_str(), name);
+        }
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Қорытынды: кадр уақыты (мс) мен өту сайын CPU/GPU орташасы (қыздырусыз)
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (double v : frameMs) sum += v;
+    const double mean = frameMs.empty() ? 0.0 : sum / frameMs.size();
+    std::printf("%d nodes, %d edges, %dx%d, %d frames (+%d warm-up), %s, %d sphere draws\n",
+                graph.count(), (int)graph.getEdges().size(), w, h, opt.frames, opt.warmup,
+                opt.impostors ? "impostors" : (opt.multiDraw && renderer.multiDrawSupported()) ? "multi-draw" : "instanced",
+                renderer.sphereDrawCalls());
+    std::printf("frame ms: mean %.3f  p50 %.3f  p95 %.3f  p99 %.3f  min %.3f  max %.3f  (%.1f fps)\n",
+                mean, percentile(sorted, 0.50), percentile(sorted, 0.95), percentile(sorted, 0.99),
+                sorted.empty() ? 0.0 : sorted.front(), sorted.empty() ? 0.0 : sorted.back(),
+                mean > 0.0 ? 1000.0 / mean : 0.0);
+    const FrameProfiler* gp = gpuTimer.supported() ? &gpuTimer.results() : nullptr;
+    for (const auto& s : prof.sections()) {
+        const FrameProfiler::Section* gs = gp ? gp->find(s.name) : nullptr;
+        if (gs) std::printf("  %-8s cpu %7.3f ms  gpu %7.3f ms\n", s.name, s.meanMs(), gs->meanMs());
+        else    std::printf("  %-8s cpu %7.3f ms\n", s.name, s.meanMs());
+    }
+    if (!gp) std::printf("  (GPU timers unavailable)\n");
+    std::printf("startup:\n");
+    for (const auto& s : startup.spans())
+        std::printf("  %8.1f  %7.2f ms  %s\n", s.startMs, s.durMs, s.name.c_str());
+    return 0;
+}
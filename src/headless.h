@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+
+// Терезесіз режим: EGL (surfaceless немесе pbuffer) контекст + FBO,
+// сценарийлі камера, кадр уақытының статистикасы, қаласа PPM кадрлар.
+//   BastauEduGraph --headless [--frames N] [--warmup N] [--size WxH] [--nodes N]
+//                  [--impostors] [--no-mdi] [--ppm DIR] [--ppm-every K]
+struct HeadlessOptions {
+    int frames = 300;
+    int warmup = 10;            // статистикаға кірмейді (шейдер/буфер құру)
+    int width = 1280, height = 720;
+    int nodes = 2000;
+    bool impostors = false;
+    bool multiDraw = true;      // --no-mdi → деңгей сайын instanced (салыстыру үшін)
+    std::string ppmDir;         // бос болса — кадр сақталмайды
+    int ppmEvery = 0;           // 0 → тек соңғы кадр
+};
+
+// Процестің шығу коды: 0 — сәтті
+int runHeadless(const HeadlessOptions& opt);
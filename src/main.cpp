@@ -1,6 +1,42 @@
 #include "app.h"
+#include "headless.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Аргументтер: жоқ болса — терезелі қосымша; --headless → headless.h
+int main(int argc, char** argv) {
+    HeadlessOptions opt;
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        const char* next = i + 1 < argc ? argv[i + 1] : nullptr;
+        if      (!std::strcmp(a, "--headless"))           headless = true;
+        else if (!std::strcmp(a, "--impostors"))          opt.impostors = true;
+        else if (!std::strcmp(a, "--no-mdi"))             opt.multiDraw = false;
+        else if (!std::strcmp(a, "--frames") && next)     opt.frames = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--warmup") && next)     opt.warmup = std::max(0, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--nodes") && next)      opt.nodes = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--ppm") && next)        opt.ppmDir = argv[++i];
+        else if (!std::strcmp(a, "--ppm-every") && next)  opt.ppmEvery = std::max(0, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--size") && next && std::sscanf(argv[++i], "%dx%d", &opt.width, &opt.height) == 2) {}
+        else {
+            std::fprintf(stderr, "usage: %s [--headless [--frames N] [--warmup N] [--size WxH] [--nodes N]"
+                                 " [--impostors] [--no-mdi] [--ppm DIR] [--ppm-every K]]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (headless) {
+#ifdef BASTAU_HEADLESS
+        return runHeadless(opt);
+#else
+        std::fprintf(stderr, "Built without EGL: headless mode unavailable\n");
+        return 1;
+#endif
+    }
 
-int main() {
     App app;
     app.run();
     return 0;
@@ -6,6 +6,7 @@ struct ControllerPanel {
     MessageBus& bus;
     int addCount = 1;     // бірден бірнеше қосу үшін
     int removeId = 0;     // нақты id-мен жою
+    int depFrom = 0, depTo = 0;
 
     void draw() {
         ImGui::Text("Total tasks: %d", bus.nodeCount());
@@ -29,6 +30,22 @@ struct ControllerPanel {
             bus.removeTask(removeId);
         }
 
+        ImGui::Separator();
+
+        // --- Dependency (from → to) ---
+        ImGui::InputInt("Dep from", &depFrom);
+        ImGui::InputInt("Dep to", &depTo);
+        if (ImGui::Button("Add dependency")) {
+            bus.addDependency(depFrom, depTo);
+        }
+        if (!bus.rejectedEdges.empty()) {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Rejected (cycle): %d", (int)bus.rejectedEdges.size());
+            const auto& r = bus.rejectedEdges.back();
+            ImGui::SameLine();
+            ImGui::Text("last %d -> %d", r.from, r.to);
+            if (ImGui::SmallButton("Clear")) bus.rejectedEdges.clear();
+        }
+
         // Қаласаңыз, ID тізімін көрсетіп қоюға болады:
         if (ImGui::CollapsingHeader("Existing IDs", ImGuiTreeNodeFlags_DefaultOpen)) {
             auto v = bus.ids();
@@ -5,8 +5,15 @@
 
 #include "core/graph.h"
 
+// Цикл жасайтындықтан қабылданбаған тәуелділік
+struct RejectedEdge {
+    int from = -1, to = -1;
+};
+
 struct MessageBus {
     Graph* g = nullptr;
+    std::vector<RejectedEdge> rejectedEdges;    // соңғылары соңында
+    static constexpr size_t kRejectedKeep = 64;
     explicit MessageBus(Graph& ref) : g(&ref) {}
 
     int nodeCount() const noexcept { return g ? g->count() : 0; }
@@ -15,10 +22,25 @@ struct MessageBus {
     int  addTask()                { return g ? g->addTask() : -1; }
     bool removeTask(int id)       { return g ? g->removeTask(id) : false; }
 
+    // Тәуелділік: цикл жасаса қабылданбайды және rejectedEdges-ке жазылады
+    bool addDependency(int fromId, int toId) {
+        if (!g) return false;
+        const DepStatus st = g->addDependency(fromId, toId);
+        if (st == DepStatus::Cycle) {
+            if (rejectedEdges.size() >= kRejectedKeep) rejectedEdges.erase(rejectedEdges.begin());
+            rejectedEdges.push_back({ fromId, toId });
+        }
+        return st == DepStatus::Added;
+    }
+
     // ✅ Worker панелінде қолдануға қалады (Done/Fail)
     void markDone(int id)         { if (g) g->setNodeState(id, NodeState::Done); }
     void markFail(int id)         { if (g) g->setNodeState(id, NodeState::Fail); }
 
+    // Топтық: тапсырма құласа, оған тәуелділердің бәрі де құлайды
+    int  failDownstream(int id)   { return g ? g->markSubtree(id, NodeState::Fail) : 0; }
+    int  doneUpstream(int id)     { return g ? g->markUpstream(id, NodeState::Done) : 0; }
+
     // Қолайлық үшін ID-лер тізімі (UI-ға пайдалы болуы мүмкін)
     std::vector<int> ids()  const { return g ? g->ids() : std::vector<int>{}; }
 };
@@ -5,6 +5,7 @@
 struct WorkerPanel {
     MessageBus& bus;
     int myId = 0;
+    int lastBulk = -1;    // соңғы топтық өзгерістің көлемі
 
     void draw() {
         ImGui::Text("Worker panel");
@@ -15,5 +16,10 @@ struct WorkerPanel {
         if (ImGui::Button("Done")) bus.markDone(myId);
         ImGui::SameLine();
         if (ImGui::Button("Fail")) bus.markFail(myId);
+
+        if (ImGui::Button("Fail + downstream")) lastBulk = bus.failDownstream(myId);
+        ImGui::SameLine();
+        if (ImGui::Button("Done + upstream")) lastBulk = bus.doneUpstream(myId);
+        if (lastBulk >= 0) ImGui::Text("Changed: %d tasks", lastBulk);
     }
 };
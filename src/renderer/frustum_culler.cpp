@@ -0,0 +1,89 @@
+#include "frustum_culler.h"
+#include "../core/graph.h"
+#include <algorithm>
+#include <cmath>
+
+void FrustumCuller::update(const Graph& g, const glm::mat4& PV, float margin, bool enabled) {
+    const int n = g.count();
+    pad = margin;
+    P.resize(n);
+    mask.assign(n, 0);
+    vis.clear();
+    tested = 0;
+    for (int i = 0; i < n; ++i) P[i] = g.displayPos(i);
+
+    // Gribb–Hartmann: жазықтықтар PV жолдарынан (glm — бағандық)
+    auto row = [&](int r) { return glm::vec4(PV[0][r], PV[1][r], PV[2][r], PV[3][r]); };
+    planes[0] = row(3) + row(0);  planes[1] = row(3) - row(0);
+    planes[2] = row(3) + row(1);  planes[3] = row(3) - row(1);
+    planes[4] = row(3) + row(2);  planes[5] = row(3) - row(2);
+    for (auto& p : planes) p /= glm::length(glm::vec3(p));
+
+    if (!enabled || n == 0) {
+        vis.resize(n);
+        for (int i = 0; i < n; ++i) { vis[i] = i; mask[i] = 1; }
+        return;
+    }
+
+    glm::vec3 lo = P[0], hi = P[0];
+    for (int i = 1; i < n; ++i) { lo = glm::min(lo, P[i]); hi = glm::max(hi, P[i]); }
+
+    // Ұяшықта орта есеппен ~8 түйін, бір оське 1..32
+    const int G = std::clamp((int)std::cbrt(n / 8.0f), 1, 32);
+    const glm::vec3 size = glm::max((hi - lo) / (float)G, glm::vec3(1e-6f));
+    const int cells = G * G * G;
+
+    cellOf.resize(n);
+    cellStart.assign(cells + 1, 0);
+    auto axis = [G](float v) { return std::clamp((int)v, 0, G - 1); };
+    for (int i = 0; i < n; ++i) {
+        glm::vec3 f = (P[i] - lo) / size;
+        cellOf[i] = (axis(f.z) * G + axis(f.y)) * G + axis(f.x);
+        ++cellStart[cellOf[i] + 1];
+    }
+    for (int c = 0; c < cells; ++c) cellStart[c + 1] += cellStart[c];
+    cellItems.resize(n);
+    cellFill.assign(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < n; ++i) cellItems[cellFill[cellOf[i]]++] = i;
+
+    for (int c = 0; c < cells; ++c) {
+        const int b = cellStart[c], e = cellStart[c + 1];
+        if (b == e) continue;
+        ++tested;
+        glm::vec3 clo = lo + glm::vec3((float)(c % G), (float)((c / G) % G), (float)(c / (G * G))) * size;
+        switch (classify(clo - glm::vec3(pad), clo + size + glm::vec3(pad))) {
+        case Side::Out: break;
+        case Side::In:
+            for (int k = b; k < e; ++k) { vis.push_back(cellItems[k]); mask[cellItems[k]] = 1; }
+            break;
+        case Side::Cross:
+            for (int k = b; k < e; ++k) {
+                int s = cellItems[k];
+                if (inside(P[s], pad)) { vis.push_back(s); mask[s] = 1; }
+            }
+            break;
+        }
+    }
+}
+
+FrustumCuller::Side FrustumCuller::classify(const glm::vec3& lo, const glm::vec3& hi) const {
+    bool cross = false;
+    for (const auto& p : planes) {
+        // p-vertex (жазықтыққа ең алыс бұрыш) сыртта болса — бүкіл қорап сыртта
+        glm::vec3 pv(p.x >= 0 ? hi.x : lo.x, p.y >= 0 ? hi.y : lo.y, p.z >= 0 ? hi.z : lo.z);
+        glm::vec3 nv(p.x >= 0 ? lo.x : hi.x, p.y >= 0 ? lo.y : hi.y, p.z >= 0 ? lo.z : hi.z);
+        if (glm::dot(glm::vec3(p), pv) + p.w < 0.0f) return Side::Out;
+        if (glm::dot(glm::vec3(p), nv) + p.w < 0.0f) cross = true;
+    }
+    return cross ? Side::Cross : Side::In;
+}
+
+bool FrustumCuller::inside(const glm::vec3& c, float r) const {
+    for (const auto& p : planes)
+        if (glm::dot(glm::vec3(p), c) + p.w < -r) return false;
+    return true;
+}
+
+bool FrustumCuller::sphereVisible(const glm::vec3& c, float r) const {
+    return inside(c, r);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+
+class Graph;
+
+// Кадр сайынғы frustum culling: түйіндер дөрекі кеңістік торына (counting
+// sort) салынады, әр ұяшықтың AABB-ы жазықтықтармен салыстырылады —
+// толық сыртта болса бүкіл ұяшық өткізіледі, толық ішінде болса бәрі
+// қабылданады, тек шекарадағы ұяшықтардың түйіндері жеке тексеріледі.
+// Нәтиже — көрінетін slot тізімі мен маска; сфера, halo, қабырға және
+// белгі өтулері бәрі соны оқиды.
+class FrustumCuller {
+public:
+    // margin — сфера/halo радиусының жоғарғы шегі (ерте кесіп тастамас үшін)
+    void update(const Graph& g, const glm::mat4& projView, float margin, bool enabled = true);
+
+    bool visible(int slot) const { return mask[slot] != 0; }
+    bool sphereVisible(const glm::vec3& c, float r) const;
+    const std::vector<int>& slots() const { return vis; }          // жасырын slot-тар да кіреді (proxy орнымен)
+    const glm::vec3& pos(int slot) const { return P[slot]; }       // displayPos кэші
+    int  visibleCount() const { return (int)vis.size(); }
+    int  total() const { return (int)P.size(); }
+    bool all() const { return (int)vis.size() == (int)P.size(); }
+    int  cellsTested() const { return tested; }
+
+private:
+    enum class Side { Out, In, Cross };
+    Side classify(const glm::vec3& lo, const glm::vec3& hi) const;
+    bool inside(const glm::vec3& p, float r) const;
+
+    glm::vec4 planes[6];                // ax+by+cz+d ≥ 0 — ішінде (қалыпталған)
+    float pad = 0.0f;
+    std::vector<glm::vec3> P;
+    std::vector<unsigned char> mask;
+    std::vector<int> vis;
+
+    // Тор: ұяшық → [cellStart[c], cellStart[c+1]) аралығындағы cellItems
+    std::vector<int> cellOf, cellStart, cellItems, cellFill;
+    int tested = 0;
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Шейдерлермен ортақ uniform блоктары (std140). GLSL жағындағы
+// `Frame` / `Materials` блоктары осы құрылымдармен дәл сәйкес болуы керек.
+namespace GpuBlocks {
+    constexpr unsigned kFrameBinding     = 0;
+    constexpr unsigned kMaterialsBinding = 1;
+
+    // Кадрда бір рет жаңарады: камера + жарықтар (әлем кеңістігінде)
+    struct Frame {
+        glm::mat4 view;
+        glm::mat4 proj;
+        glm::vec4 eye;              // xyz
+        glm::vec4 lightDir[2];      // қалыпталған бағыт (бетке қарай емес — жарыққа қарай)
+        glm::vec4 lightColor[2];    // rgb — диффуз, w — specular күші
+        glm::vec4 ambient;          // rgb
+    };
+
+    // Тұрақты: күй бойынша материал кестесі
+    struct Materials {
+        glm::vec4 stateDiffuse[4];  // NodeState реті
+        glm::vec4 specular;         // rgb, w — shininess
+    };
+
+    // glMultiDrawElementsIndirect командасы (GL спецификациясындағы орналасу)
+    struct DrawElementsIndirect {
+        unsigned count;             // индекс саны (LOD торы)
+        unsigned instanceCount;
+        unsigned firstIndex;
+        int      baseVertex;
+        unsigned baseInstance;      // инстанс буферіндегі бөлік басы
+    };
+
+    // beginLighting()-тегі key/fill жарықтары — екі бэкенд бірдей көрінсін
+    constexpr float kLightPos[2][3]   = { {  0.6f,  1.0f,  0.8f }, { -0.7f, -0.4f, -0.6f } };
+    constexpr float kLightDif[2][3]   = { {  0.95f, 0.95f, 0.95f }, {  0.45f, 0.45f, 0.50f } };
+    constexpr float kLightSpec[2]     = { 0.35f, 0.05f };
+    constexpr float kGlobalAmbient[3] = { 0.18f, 0.18f, 0.20f };
+    // Шейдерде ambient негізгі түске көбейтіледі (бұрынғы sphere.frag көрінісі)
+    constexpr float kShaderAmbient[3] = { 0.22f, 0.22f, 0.24f };
+}
@@ -2,38 +2,44 @@
 #include <glad/glad.h>
 #include <glm/gtc/constants.hpp>
 #include "../ui/theme.h"
+#include "sphere_mesh.h"
+#include "sphere_lod.h"
+#include "gpu_blocks.h"
+
+#ifndef BASTAU_ASSET_DIR
+#define BASTAU_ASSET_DIR "assets"
+#endif
+#ifndef BASTAU_SHADER_CACHE_DIR
+#define BASTAU_SHADER_CACHE_DIR "shader_cache"
+#endif
 
 static constexpr float kSphereR = 0.07f;
 
+GraphRenderer::GraphRenderer() : shaders(BASTAU_ASSET_DIR "/shaders", BASTAU_SHADER_CACHE_DIR) {}
+
 void GraphRenderer::beginLighting() {
     glEnable(GL_LIGHTING);
 
+    using namespace GpuBlocks;
+
     // Глобал ambient — көлеңке тым қара болмасын
-    GLfloat GlobalAmb[4] = { 0.18f, 0.18f, 0.20f, 1.0f };
+    GLfloat GlobalAmb[4] = { kGlobalAmbient[0], kGlobalAmbient[1], kGlobalAmbient[2], 1.0f };
     glLightModelfv(GL_LIGHT_MODEL_AMBIENT, GlobalAmb);
     glLightModelf(GL_LIGHT_MODEL_TWO_SIDE, GL_FALSE);
 
-    // Негізгі бағытталған жарық (key light)
-    glEnable(GL_LIGHT0);
-    GLfloat L0_pos[4] = {  0.6f,  1.0f,  0.8f, 0.0f }; // w=0 → directional
-    GLfloat L0_dif[4] = {  0.95f, 0.95f, 0.95f, 1.0f };
-    GLfloat L0_spc[4] = {  0.35f, 0.35f, 0.35f, 1.0f };
-    GLfloat L0_amb[4] = {  0.00f, 0.00f, 0.00f, 1.0f };
-    glLightfv(GL_LIGHT0, GL_POSITION, L0_pos);
-    glLightfv(GL_LIGHT0, GL_DIFFUSE,  L0_dif);
-    glLightfv(GL_LIGHT0, GL_SPECULAR, L0_spc);
-    glLightfv(GL_LIGHT0, GL_AMBIENT,  L0_amb);
-
-    // Қарсы жақтан жұмсақ «fill» жарық — жартылай көлеңке эффекті
-    glEnable(GL_LIGHT1);
-    GLfloat L1_pos[4] = { -0.7f, -0.4f, -0.6f, 0.0f };
-    GLfloat L1_dif[4] = {  0.45f, 0.45f, 0.50f, 1.0f }; // әлсіз, салқын рең
-    GLfloat L1_spc[4] = {  0.05f, 0.05f, 0.08f, 1.0f };
-    GLfloat L1_amb[4] = {  0.00f, 0.00f, 0.00f, 1.0f };
-    glLightfv(GL_LIGHT1, GL_POSITION, L1_pos);
-    glLightfv(GL_LIGHT1, GL_DIFFUSE,  L1_dif);
-    glLightfv(GL_LIGHT1, GL_SPECULAR, L1_spc);
-    glLightfv(GL_LIGHT1, GL_AMBIENT,  L1_amb);
+    // 0 — негізгі бағытталған жарық (key light), 1 — қарсы жақтан жұмсақ «fill»
+    for (int i = 0; i < 2; ++i) {
+        const GLenum L = GL_LIGHT0 + i;
+        GLfloat pos[4] = { kLightPos[i][0], kLightPos[i][1], kLightPos[i][2], 0.0f }; // w=0 → directional
+        GLfloat dif[4] = { kLightDif[i][0], kLightDif[i][1], kLightDif[i][2], 1.0f };
+        GLfloat spc[4] = { kLightSpec[i], kLightSpec[i], kLightSpec[i], 1.0f };
+        GLfloat amb[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        glEnable(L);
+        glLightfv(L, GL_POSITION, pos);
+        glLightfv(L, GL_DIFFUSE,  dif);
+        glLightfv(L, GL_SPECULAR, spc);
+        glLightfv(L, GL_AMBIENT,  amb);
+    }
 }
 
 void GraphRenderer::endLighting() {
@@ -41,121 +47,681 @@ void GraphRenderer::endLighting() {
     glDisable(GL_LIGHTING);
 }
 
-void GraphRenderer::setColorByState(NodeState st) {
-    Theme::setMaterialByState(st);
+float GraphRenderer::proxyRadius(const TaskGroup& g) {
+    // Көлемі тапсырма санына пропорционал
+    return kSphereR * (1.0f + 0.6f * std::cbrt((float)std::max(1, g.total)));
 }
 
 void GraphRenderer::drawBounds(float B) {
-    glDisable(GL_LIGHTING);
-    glLineWidth(1.0f);
-    glColor4f(1,1,1,0.15f);
-    glBegin(GL_LINES);
+    const float WHITE[3] = { 1, 1, 1 };
     const float s = B;
-    // 12 ребра куба
-    auto V=[&](float x,float y,float z){ glVertex3f(x,y,z); };
-    // low square
-    V(-s,-s,-s); V(+s,-s,-s);
-    V(+s,-s,-s); V(+s,-s,+s);
-    V(+s,-s,+s); V(-s,-s,+s);
-    V(-s,-s,+s); V(-s,-s,-s);
-    // high square
-    V(-s,+s,-s); V(+s,+s,-s);
-    V(+s,+s,-s); V(+s,+s,+s);
-    V(+s,+s,+s); V(-s,+s,+s);
-    V(-s,+s,+s); V(-s,+s,-s);
-    // verticals
-    V(-s,-s,-s); V(-s,+s,-s);
-    V(+s,-s,-s); V(+s,+s,-s);
-    V(+s,-s,+s); V(+s,+s,+s);
-    V(-s,-s,+s); V(-s,+s,+s);
-    glEnd();
+    // 12 ребра куба: төменгі/жоғарғы шаршылар + тіктер
+    const glm::vec3 c[4] = { { -s, 0, -s }, { +s, 0, -s }, { +s, 0, +s }, { -s, 0, +s } };
+    for (int i = 0; i < 4; ++i) {
+        const glm::vec3& p = c[i];
+        const glm::vec3& q = c[(i + 1) % 4];
+        lines.line({ p.x, -s, p.z }, { q.x, -s, q.z }, WHITE, 0.15f);
+        lines.line({ p.x, +s, p.z }, { q.x, +s, q.z }, WHITE, 0.15f);
+        lines.line({ p.x, -s, p.z }, { p.x, +s, p.z }, WHITE, 0.15f);
+    }
+    lines.flush(1.0f);
+}
+
+// Тесселяция (stacks, slices) бойынша бір рет құрылады — кадр сайын тригонометрия жоқ
+const SphereMesh& GraphRenderer::cachedSphere(int stacks, int slices) {
+    static std::map<std::pair<int,int>, SphereMesh> cache;
+    auto it = cache.find({ stacks, slices });
+    if (it == cache.end()) it = cache.emplace(std::make_pair(stacks, slices), SphereMesh::build(stacks, slices)).first;
+    return it->second;
 }
 
+// Кэштелген торды client array арқылы қайталау; нормальдар glScalef-тен кейін қайта қалыпталады
 void GraphRenderer::drawSphere(float r, int stacks, int slices) {
-    const float PI = glm::pi<float>(), TWO_PI = 2.0f*PI;
-    for (int i = 0; i < stacks; ++i) {
-        float v0 = (float)i / stacks;
-        float v1 = (float)(i+1) / stacks;
-        float t0 = v0 * PI, t1 = v1 * PI;
-
-        glBegin(GL_TRIANGLE_STRIP);
-        for (int j = 0; j <= slices; ++j) {
-            float u = (float)j / slices;
-            float phi = u * TWO_PI;
-
-            float x0 = sinf(t0)*cosf(phi), y0 = cosf(t0), z0 = sinf(t0)*sinf(phi);
-            float x1 = sinf(t1)*cosf(phi), y1 = cosf(t1), z1 = sinf(t1)*sinf(phi);
-
-            glNormal3f(x1,y1,z1); glVertex3f(r*x1, r*y1, r*z1);
-            glNormal3f(x0,y0,z0); glVertex3f(r*x0, r*y0, r*z0);
+    const SphereMesh& m = cachedSphere(stacks, slices);
+    glPushMatrix();
+    glScalef(r, r, r);
+    glEnable(GL_RESCALE_NORMAL);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, m.pos.data());
+    glNormalPointer(GL_FLOAT, 0, m.pos.data());
+    glDrawElements(GL_TRIANGLES, (GLsizei)m.idx.size(), GL_UNSIGNED_INT, m.idx.data());
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisable(GL_RESCALE_NORMAL);
+    glPopMatrix();
+}
+
+// Түс таңдау реті: шард → қауымдастық → маңыздылық → күй
+void GraphRenderer::slotColor(const Graph& graph, const RenderOptions& ro, int slot, float rgb[3]) {
+    const int ck = ro.communityKey ? (*ro.communityKey)[slot] : -1;
+    const float* c = nullptr;
+    if (ro.colorByShard)                          c = Theme::SHARD[graph.partition().partOf(slot) % 8];
+    else if (ck >= 0)                             { Theme::keyColor(ck, rgb); return; }
+    else if (ro.importance && ro.importanceColor) { Theme::heat((*ro.importance)[slot], rgb); return; }
+    else                                          c = Theme::stateColor(graph.getNodes()[slot].state);
+    rgb[0] = c[0]; rgb[1] = c[1]; rgb[2] = c[2];
+}
+
+float GraphRenderer::slotRadius(const RenderOptions& ro, int slot) {
+    return (ro.importance && ro.importanceScale) ? kSphereR * (0.7f + 0.9f * (*ro.importance)[slot]) : kSphereR;
+}
+
+long long GraphRenderer::sphereVertices() const {
+    if (usedImpostors) return (long long)instSlots.size() * 4;
+    long long v = 0;
+    for (int l = 0; l < SphereLod::kLevels; ++l)
+        v += (long long)lodInstances(l) * (SphereLod::kStacks[l] + 1) * (SphereLod::kSlices[l] + 1);
+    return v;
+}
+
+// GL ресурстары алғашқы кадрда бір рет құрылады; шейдер болмаса — ескі жол
+bool GraphRenderer::initGpu() {
+    gpuTried = true;
+    // Core profile: glBegin/glLight/матрица стегі жоқ — тек шейдер жолы
+    GLint profile = 0;
+    glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profile);
+    core = (profile & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+
+    sphereShader = shaders.load("sphere");
+    if (!sphereShader->ok) return false;
+
+    // Барлық LOD деңгейі бір VBO/IBO-да; индекстер деңгейдің base vertex-іне жылжытылған
+    SphereMesh mesh;
+    for (int l = 0; l < SphereLod::kLevels; ++l) {
+        SphereMesh m = SphereMesh::build(SphereLod::kStacks[l], SphereLod::kSlices[l]);
+        const unsigned base = (unsigned)mesh.vertexCount();
+        lodFirst[l] = (int)mesh.idx.size();
+        lodIndexCount[l] = (int)m.idx.size();
+        mesh.pos.insert(mesh.pos.end(), m.pos.begin(), m.pos.end());
+        for (unsigned i : m.idx) mesh.idx.push_back(base + i);
+    }
+
+    glGenVertexArrays(1, &sphereVao);
+    glGenBuffers(1, &sphereVbo);
+    glGenBuffers(1, &sphereIbo);
+    glGenBuffers(1, &posBuf);
+    glGenBuffers(1, &colorBuf);
+    glGenBuffers(1, &instBuf);
+    glGenBuffers(1, &indirectBuf);
+    // glMultiDrawElementsIndirect + baseInstance: 4.3 немесе сәйкес кеңейтулер
+    mdiOk = GLAD_GL_VERSION_4_3 || (GLAD_GL_ARB_multi_draw_indirect && GLAD_GL_ARB_base_instance);
+
+    glBindVertexArray(sphereVao);
+    glBindBuffer(GL_ARRAY_BUFFER, sphereVbo);
+    glBufferData(GL_ARRAY_BUFFER, mesh.pos.size() * sizeof(float), mesh.pos.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sphereIbo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.idx.size() * sizeof(unsigned), mesh.idx.data(), GL_STATIC_DRAW);
+
+    // Инстанс = көрінетін slot; орын мен түс slot бойынша texelFetch арқылы
+    glBindBuffer(GL_ARRAY_BUFFER, instBuf);
+    glEnableVertexAttribArray(1);
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(unsigned), (void*)0);
+    glVertexAttribDivisor(1, 1);
+
+    // Атау тек байланыстырғанда объектке айналады — glTexBuffer-ге дейін
+    glBindBuffer(GL_TEXTURE_BUFFER, posBuf);
+    glBindBuffer(GL_TEXTURE_BUFFER, colorBuf);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    glGenTextures(1, &posTex);
+    glBindTexture(GL_TEXTURE_BUFFER, posTex);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, posBuf);
+    glGenTextures(1, &colorTex);
+    glBindTexture(GL_TEXTURE_BUFFER, colorTex);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8, colorBuf);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    // Impostor: квад + сол инстанс тізімі; фрагментте сфера ray-cast (шейдер болмаса — mesh)
+    impostorShader = shaders.load("impostor");
+    if (impostorShader->ok) {
+        const float quad[8] = { -1, -1,  1, -1,  -1, 1,  1, 1 };
+        glGenVertexArrays(1, &impostorVao);
+        glGenBuffers(1, &quadVbo);
+        glBindVertexArray(impostorVao);
+        glBindBuffer(GL_ARRAY_BUFFER, quadVbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        glBindBuffer(GL_ARRAY_BUFFER, instBuf);
+        glEnableVertexAttribArray(1);
+        glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(unsigned), (void*)0);
+        glVertexAttribDivisor(1, 1);
+    }
+
+    // Белгілер (жарқылдар, proxy сфералар): сфера торы + шағын динамикалық инстанс буферлері
+    markerShader = shaders.load("marker");
+    if (!markerShader->ok) return false;
+    glGenVertexArrays(1, &markerVao);
+    glGenBuffers(1, &markerPosBuf);
+    glGenBuffers(1, &markerColorBuf);
+    glBindVertexArray(markerVao);
+    glBindBuffer(GL_ARRAY_BUFFER, sphereVbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sphereIbo);
+    glBindBuffer(GL_ARRAY_BUFFER, markerPosBuf);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glVertexAttribDivisor(1, 1);
+    glBindBuffer(GL_ARRAY_BUFFER, markerColorBuf);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glVertexAttribDivisor(2, 1);
+
+    // Қабырғалар: сол posBuf + өз индекс буфері (шейдер болмаса — ескі жол)
+    edgeShader = shaders.load("edge");
+    if (edgeShader->ok) {
+        glGenVertexArrays(1, &edgeVao);
+        glGenBuffers(1, &edgeIbo);
+        glGenBuffers(1, &edgeCullIbo);
+        glBindVertexArray(edgeVao);
+        glBindBuffer(GL_ARRAY_BUFFER, posBuf);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Ортақ uniform блоктары: камера/жарық кадрда бір рет, материалдар бір рет
+    // (байланыс Shader-де сақталады — hot-reload-тан кейін қайта қолданылады)
+    for (Shader* sh : { sphereShader, impostorShader, markerShader, edgeShader }) {
+        sh->bindBlock("Frame", GpuBlocks::kFrameBinding);
+        sh->bindBlock("Materials", GpuBlocks::kMaterialsBinding);
+    }
+    GpuBlocks::Materials mat;
+    for (int s = 0; s < kStates; ++s) {
+        const float* c = Theme::stateColor((NodeState)s);
+        mat.stateDiffuse[s] = glm::vec4(c[0], c[1], c[2], 1.0f);
+    }
+    mat.specular = glm::vec4(Theme::SPC[0], Theme::SPC[1], Theme::SPC[2], Theme::SHININESS);
+
+    glGenBuffers(1, &frameUbo);
+    glBindBuffer(GL_UNIFORM_BUFFER, frameUbo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(GpuBlocks::Frame), nullptr, GL_DYNAMIC_DRAW);
+    glGenBuffers(1, &materialsUbo);
+    glBindBuffer(GL_UNIFORM_BUFFER, materialsUbo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(GpuBlocks::Materials), &mat, GL_STATIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, GpuBlocks::kFrameBinding, frameUbo);
+    glBindBufferBase(GL_UNIFORM_BUFFER, GpuBlocks::kMaterialsBinding, materialsUbo);
+
+    lines.init(shaders);
+    return true;
+}
+
+// Түс тек күйден шыға ма (шард/қауымдастық/heat жоқ) — онда бөлік бір түспен сызылады
+bool GraphRenderer::stateColored(const RenderOptions& ro) {
+    return !ro.colorByShard && !ro.communityKey && !(ro.importance && ro.importanceColor);
+}
+
+// Әр кадр: slot бойынша орын+радиус және түс (жасырын тапсырма — радиус 0),
+// сосын бөліктерге топталған инстанс тізімі. Күй түсінде slot түсі керек емес.
+void GraphRenderer::uploadInstances(const Graph& graph, const RenderOptions& ro) {
+    const int n = graph.count();
+    const auto& groups = graph.groups();
+    instPos.resize((size_t)n * 4);
+    for (int i = 0; i < n; ++i) {
+        const bool hidden = groups.hidden(i);
+        const glm::vec3& p = cull.pos(i);
+        float* dst = &instPos[(size_t)i * 4];
+        dst[0] = p.x; dst[1] = p.y; dst[2] = p.z;
+        dst[3] = hidden ? 0.0f : slotRadius(ro, i);
+    }
+
+    // Orphaning: драйвер алдыңғы кадр буферін күтпейді
+    glBindBuffer(GL_ARRAY_BUFFER, posBuf);
+    glBufferData(GL_ARRAY_BUFFER, instPos.size() * sizeof(float), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instPos.size() * sizeof(float), instPos.data());
+
+    if (!stateColored(ro)) {
+        instColor.resize(n);
+        for (int i = 0; i < n; ++i) {
+            float rgb[3];
+            slotColor(graph, ro, i, rgb);
+            instColor[i] = (uint32_t)(rgb[0] * 255.0f) | ((uint32_t)(rgb[1] * 255.0f) << 8)
+                         | ((uint32_t)(rgb[2] * 255.0f) << 16) | (255u << 24);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, colorBuf);
+        glBufferData(GL_ARRAY_BUFFER, instColor.size() * sizeof(uint32_t), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instColor.size() * sizeof(uint32_t), instColor.data());
+    }
+
+    // Инстанс = slot | күй << kStateShift: шейдер күй түсін бөлік uniform-сыз біледі,
+    // сондықтан бүкіл тізім бір шақыруда (MDI / impostor) сызыла алады
+    instPacked.resize(instSlots.size());
+    for (int b = 0; b < kBuckets; ++b) {
+        const unsigned st = (unsigned)(b % kStates) << kStateShift;
+        for (int k = bucketStart[b]; k < bucketStart[b + 1]; ++k) instPacked[k] = instSlots[k] | st;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, instBuf);
+    glBufferData(GL_ARRAY_BUFFER, instPacked.size() * sizeof(unsigned), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instPacked.size() * sizeof(unsigned), instPacked.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Көрінетін әрі жасырын емес slot-тарға LOD деңгейі (экрандағы радиус бойынша,
+// гистерезиспен), сосын (деңгей, күй) бөліктеріне кадр сайын counting sort — әдейі:
+// LOD бәрібір әр көрінетін slot үшін есептеледі, ал StateIndex тізімдерін cull
+// маскасымен қиып жүру O(n) болар еді, бұл — O(көрінетін). Күй StateIndex-тің
+// қысылған векторынан O(1) оқылады, салыстырмалы сұрыптау жоқ.
+void GraphRenderer::assignBuckets(const Graph& graph, const Camera3D& cam, int h, const RenderOptions& ro) {
+    const int n = graph.count();
+    const auto& groups = graph.groups();
+    const glm::vec3 eye = cam.getEye();
+    const float focal = (float)h / (2.0f * std::tan(glm::radians(cam.fov_deg) * 0.5f));
+    lodOf.resize(n, SphereLod::kNone);
+    lodOwner.resize(n, -1);
+
+    const StateIndex& st = graph.states();
+    auto bucketOf = [&](int s) { return lodOf[s] * kStates + (int)st.stateAt(s); };
+
+    int counts[kBuckets] = {};
+    for (int s : cull.slots()) {
+        if (groups.hidden(s)) continue;
+        const float dist = std::max(glm::length(cull.pos(s) - eye), cam.znear);
+        const float px = slotRadius(ro, s) * focal / dist;
+        const int id = graph.getNodes()[s].id;
+        if (lodOwner[s] != id) { lodOwner[s] = id; lodOf[s] = SphereLod::kNone; }   // slot-қа басқа тапсырма көшті
+        lodOf[s] = (unsigned char)SphereLod::select(lodOf[s], px);
+        ++counts[bucketOf(s)];
+    }
+    bucketStart[0] = 0;
+    for (int b = 0; b < kBuckets; ++b) bucketStart[b + 1] = bucketStart[b] + counts[b];
+    int fill[kBuckets];
+    for (int b = 0; b < kBuckets; ++b) fill[b] = bucketStart[b];
+    instSlots.resize(bucketStart[kBuckets]);
+    for (int s : cull.slots())
+        if (!groups.hidden(s)) instSlots[fill[bucketOf(s)]++] = (unsigned)s;
+}
+
+// Күй түсінде slot-тың жоғарғы биттеріндегі күй `Materials` кестесінен оқылады,
+// әйтпесе түс uColors буферінен — шақырулар арасында uniform ауыстыру жоқ
+void GraphRenderer::bindSphereInputs(const Shader& sh, bool byState) {
+    sh.use();
+    sh.setInt("uPosRadius", 0);
+    sh.setInt("uColors", 1);
+    sh.setInt("uStateColored", byState ? 1 : 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, posTex);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, colorTex);
+}
+
+void GraphRenderer::unbindSphereInputs() {
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glUseProgram(0);
+}
+
+// Multi-draw indirect: (деңгей, күй) бөлігіне бір команда, бәрі бір шақыруда;
+// baseInstance инстанс атрибутын бөліктің басына жылжытады.
+// Қолдау болмаса — деңгей сайын бір instanced шақыру (атрибут жылжытылады).
+void GraphRenderer::drawSpheresInstanced(bool byState, bool multiDraw) {
+    bindSphereInputs(*sphereShader, byState);
+    glBindVertexArray(sphereVao);
+    sphereDraws = 0;
+    if (multiDraw && mdiOk) {
+        drawCmds.clear();
+        for (int b = 0; b < kBuckets; ++b) {
+            const int count = bucketStart[b + 1] - bucketStart[b];
+            if (count == 0) continue;
+            const int l = b / kStates;
+            drawCmds.push_back({ (unsigned)lodIndexCount[l], (unsigned)count, (unsigned)lodFirst[l], 0,
+                                 (unsigned)bucketStart[b] });
+        }
+        if (!drawCmds.empty()) {
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuf);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, drawCmds.size() * sizeof(GpuBlocks::DrawElementsIndirect),
+                         drawCmds.data(), GL_STREAM_DRAW);
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, (GLsizei)drawCmds.size(), 0);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+            sphereDraws = 1;
+        }
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, instBuf);
+        for (int l = 0; l < SphereLod::kLevels; ++l) {
+            const int first = bucketStart[l * kStates];
+            const int count = bucketStart[(l + 1) * kStates] - first;
+            if (count == 0) continue;
+            glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(unsigned), (void*)(first * sizeof(unsigned)));
+            glDrawElementsInstanced(GL_TRIANGLES, lodIndexCount[l], GL_UNSIGNED_INT,
+                                    (void*)(lodFirst[l] * sizeof(unsigned)), count);
+            ++sphereDraws;
+        }
+        glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(unsigned), (void*)0);   // MDI baseInstance 0-ден санайды
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    unbindSphereInputs();
+}
+
+// Қабырға топологиясы slot индекстерімен — орындар posBuf-та, сондықтан
+// кадр сайын ештеңе жүктелмейді; тек topologyVersion өзгергенде
+void GraphRenderer::uploadEdges(const Graph& graph) {
+    if (graph.topologyVersion() == edgeTopo) return;
+    edgeTopo = graph.topologyVersion();
+    const auto& E = graph.getEdges();
+    edgeIdx.resize(E.size() * 2);
+    for (size_t e = 0; e < E.size(); ++e) {
+        edgeIdx[e * 2]     = (unsigned)E[e].from;
+        edgeIdx[e * 2 + 1] = (unsigned)E[e].to;
+    }
+    edgeIndexCount = (int)edgeIdx.size();
+    glBindBuffer(GL_ARRAY_BUFFER, edgeIbo);
+    glBufferData(GL_ARRAY_BUFFER, edgeIdx.size() * sizeof(unsigned), edgeIdx.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Әр көрінетін түйін — бір квад (4 төбе), LOD-қа да, күйге де қарамай бір шақыру
+void GraphRenderer::drawSpheresImpostor(bool byState) {
+    bindSphereInputs(*impostorShader, byState);
+    glBindVertexArray(impostorVao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)instSlots.size());
+    sphereDraws = instSlots.empty() ? 0 : 1;
+    unbindSphereInputs();
+}
+
+// Culling кезінде: көрінетін түйіннің шығыс қабырғалары + көрінбейтін
+// түйіннен келетін кіріс қабырғалары — әр қабырға бір рет, O(көрінетін дәрежесі)
+int GraphRenderer::uploadCulledEdges(const Graph& graph) {
+    const auto& E = graph.getEdges();
+    edgeCullIdx.clear();
+    for (int s : cull.slots()) {
+        for (int e : graph.outEdgesOf(s)) {
+            edgeCullIdx.push_back((unsigned)s);
+            edgeCullIdx.push_back((unsigned)E[e].to);
+        }
+        for (int e : graph.inEdgesOf(s)) {
+            if (cull.visible(E[e].from)) continue;
+            edgeCullIdx.push_back((unsigned)E[e].from);
+            edgeCullIdx.push_back((unsigned)s);
         }
-        glEnd();
     }
+    glBindBuffer(GL_ARRAY_BUFFER, edgeCullIbo);     // VAO күйін бұзбау үшін ARRAY ретінде жүктейміз
+    glBufferData(GL_ARRAY_BUFFER, edgeCullIdx.size() * sizeof(unsigned), edgeCullIdx.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return (int)edgeCullIdx.size();
+}
+
+void GraphRenderer::drawEdgesIndexed(unsigned ibo, int count) {
+    if (count == 0 || !edgeVao) return;
+    edgeShader->use();
+    edgeShader->setVec4("uColor", 1.0f, 1.0f, 1.0f, 0.35f);
+    glLineWidth(1.5f);
+    glBindVertexArray(edgeVao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+    glDrawElements(GL_LINES, count, GL_UNSIGNED_INT, (void*)0);
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+// Ховер әсері: ішкі қабырғалар түсті сызық, түйіндер жарқыл — құны O(әсер өлшемі)
+void GraphRenderer::drawImpact(const Graph& graph, int hoveredId, const RenderOptions& ro) {
+    int hs = graph.slotOf(hoveredId);
+    if (hs < 0 || !ro.impactDown || !ro.impactUp) return;
+    if (ro.impactDown->empty() && ro.impactUp->empty()) return;
+
+    impactMark.resize(graph.count(), 0);
+    for (int s : *ro.impactDown) impactMark[s] = 1;
+    for (int s : *ro.impactUp)   impactMark[s] = 2;
+    impactMark[hs] = 3;
+
+    const auto& E = graph.getEdges();
+    auto edgesFrom = [&](int s, unsigned char want, const float* rgb) {
+        for (int e : graph.outEdgesOf(s)) {
+            int t = E[e].to;
+            if (impactMark[t] != want && !(want == 2 && impactMark[t] == 3)) continue;
+            lines.line(graph.displayPos(s), graph.displayPos(t), rgb, 0.8f);
+        }
+    };
+    edgesFrom(hs, 1, Theme::IMP_DN);
+    for (int s : *ro.impactDown) edgesFrom(s, 1, Theme::IMP_DN);
+    for (int s : *ro.impactUp)   edgesFrom(s, 2, Theme::IMP_UP);
+    lines.flush(2.5f);
+
+    for (int s : *ro.impactDown) impactMark[s] = 0;
+    for (int s : *ro.impactUp)   impactMark[s] = 0;
+    impactMark[hs] = 0;
+}
+
+// Кадрда бір рет: камера мен жарықтар `Frame` UBO-ға
+void GraphRenderer::updateFrameBlock(const Camera3D& cam, int w, int h) {
+    using namespace GpuBlocks;
+    Frame f;
+    f.view = cam.view();
+    f.proj = cam.proj(w, h);
+    const glm::vec3 eye = cam.getEye();
+    f.eye = glm::vec4(eye.x, eye.y, eye.z, 1.0f);
+    for (int i = 0; i < 2; ++i) {
+        glm::vec3 d = glm::normalize(glm::vec3(kLightPos[i][0], kLightPos[i][1], kLightPos[i][2]));
+        f.lightDir[i]   = glm::vec4(d.x, d.y, d.z, 0.0f);
+        f.lightColor[i] = glm::vec4(kLightDif[i][0], kLightDif[i][1], kLightDif[i][2], kLightSpec[i]);
+    }
+    f.ambient = glm::vec4(kShaderAmbient[0], kShaderAmbient[1], kShaderAmbient[2], 1.0f);
+    glBindBuffer(GL_UNIFORM_BUFFER, frameUbo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Frame), &f);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+// Шағын инстанс тізімі (орын+радиус, RGBA) — proxy сфералар (lit) мен жарқылдар
+void GraphRenderer::drawMarkers(const std::vector<float>& posR, const std::vector<float>& rgba, int lod, bool lit) {
+    const int count = (int)posR.size() / 4;
+    if (count == 0) return;
+    glBindBuffer(GL_ARRAY_BUFFER, markerPosBuf);
+    glBufferData(GL_ARRAY_BUFFER, posR.size() * sizeof(float), posR.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, markerColorBuf);
+    glBufferData(GL_ARRAY_BUFFER, rgba.size() * sizeof(float), rgba.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    markerShader->use();
+    markerShader->setInt("uLit", lit ? 1 : 0);
+    glBindVertexArray(markerVao);
+    glDrawElementsInstanced(GL_TRIANGLES, lodIndexCount[lod], GL_UNSIGNED_INT,
+                            (void*)(lodFirst[lod] * sizeof(unsigned)), count);
+    glBindVertexArray(0);
+    glUseProgram(0);
 }
 
 void GraphRenderer::render(const Graph& graph, const Camera3D& cam, int w, int h,
                            int hoveredId, const RenderOptions& ro) {
+    FrameProfiler::Scope frame(ro.profiler, "render");
 
     // World size estimate (same formula as in Graph::update)
     int n = graph.count();
     float worldR = std::max(1.2f, 0.28f * std::cbrt((float)std::max(1,n)));
     float B = worldR + 0.6f;
 
+    // Бэкенд: core profile-да тек шейдер жолы; compat-та инстанстауды өшіруге болады
+    if (!gpuTried) gpuOk = initGpu();
+    shaders.poll();                                 // өзгерген шейдер файлдары → қайта құру
+    if (core && !gpuOk) return;                     // fixed-function жоқ — сызатын ештеңе жоқ
+    const bool gpu = gpuOk && (core || ro.instanced);
+
     glEnable(GL_DEPTH_TEST);
-    cam.apply(w, h);
+    if (gpuOk) updateFrameBlock(cam, w, h);         // сызықтар шейдерімен ескі жолда да керек
+    if (!gpu)  cam.apply(w, h);
+    if (!core) glDisable(GL_LIGHTING);
 
     // Axes (subtle)
-    glDisable(GL_LIGHTING);
-    glLineWidth(1.0f);
-    glBegin(GL_LINES);
-        glColor3f(1,0,0); glVertex3f(-2,0,0); glVertex3f(2,0,0);
-        glColor3f(0,1,0); glVertex3f(0,-2,0); glVertex3f(0,2,0);
-        glColor3f(0,0,1); glVertex3f(0,0,-2); glVertex3f(0,0,2);
-    glEnd();
+    const float RED[3] = { 1, 0, 0 }, GREEN[3] = { 0, 1, 0 }, BLUE[3] = { 0, 0, 1 }, WHITE[3] = { 1, 1, 1 };
+    lines.line({ -2, 0, 0 }, { 2, 0, 0 }, RED,   1.0f);
+    lines.line({ 0, -2, 0 }, { 0, 2, 0 }, GREEN, 1.0f);
+    lines.line({ 0, 0, -2 }, { 0, 0, 2 }, BLUE,  1.0f);
+    lines.flush(1.0f);
 
     if (ro.showBounds) drawBounds(B);
 
+    // Көрінетін жиын: барлық өтулер (сфера, halo, қабырға, белгі) осыны оқиды
+    {
+        FrameProfiler::Scope pass(ro.profiler, "cull");
+        cull.update(graph, cam.proj(w, h) * cam.view(), kSphereR * 2.2f, ro.cull);
+        assignBuckets(graph, cam, h, ro);
+    }
+
+    // GPU жолы: slot буферлері кадрда бір рет — сфералар да, қабырғалар да оқиды
+    if (gpu && n > 0) {
+        FrameProfiler::Scope pass(ro.profiler, "upload");
+        GpuTimer::Scope gpuPass(ro.gpuTimer, "upload");
+        uploadInstances(graph, ro);
+    }
+
     // Edges (егер бар болса)
-    if (ro.showEdges) {
-        glDisable(GL_LIGHTING);
-        glLineWidth(1.5f);
-        glColor4f(1,1,1,0.35f);
-        glBegin(GL_LINES);
+    if (ro.showEdges && gpu) {
+        FrameProfiler::Scope pass(ro.profiler, "edges");
+        GpuTimer::Scope gpuPass(ro.gpuTimer, "edges");
+        if (cull.all()) {
+            uploadEdges(graph);
+            drawEdgesIndexed(edgeIbo, edgeIndexCount);
+        } else {
+            int count = uploadCulledEdges(graph);
+            drawEdgesIndexed(edgeCullIbo, count);
+        }
+    } else if (ro.showEdges) {
+        FrameProfiler::Scope pass(ro.profiler, "edges");
+        GpuTimer::Scope gpuPass(ro.gpuTimer, "edges");
         for (const auto& e : graph.getEdges()) {
-
-            const auto& A = graph.getNodes()[e.from];
-            const auto& C = graph.getNodes()[e.to];
-            glVertex3f(A.pos.x, A.pos.y, A.pos.z);
-            glVertex3f(C.pos.x, C.pos.y, C.pos.z);
+            if (!cull.visible(e.from) && !cull.visible(e.to)) continue;
+            // Жабық топтағы ұштар proxy-ге бағытталады
+            const glm::vec3& A = cull.pos(e.from);
+            const glm::vec3& C = cull.pos(e.to);
+            if (A == C) continue;
+            lines.line(A, C, WHITE, 0.35f);
         }
-        glEnd();
+        lines.flush(1.5f);
     }
 
-    // Lighting on for spheres
-    beginLighting();
+    // Критикалық жол — қалың сызық
+    const auto& crit = graph.criticalPath();
+    if (ro.showCritical && crit.size() > 1) {
+        for (size_t i = 1; i < crit.size(); ++i)
+            lines.line(graph.displayPos(crit[i - 1]), graph.displayPos(crit[i]), Theme::CRIT, 0.9f);
+        lines.flush(3.5f);
+    }
 
-    for (const auto& n0 : graph.getNodes()) {
-        setColorByState(n0.state);
+    // Сфералар: GPU инстанстау (деңгей/бөлік сайын бір шақыру) немесе ескі immediate жол
+    const auto& groups = graph.groups();
+    {
+        FrameProfiler::Scope pass(ro.profiler, "spheres");
+        GpuTimer::Scope gpuPass(ro.gpuTimer, "spheres");
+        usedImpostors = gpu && ro.impostors && impostorVao;
+        if (gpu && !instSlots.empty()) {
+            if (usedImpostors) drawSpheresImpostor(stateColored(ro));
+            else               drawSpheresInstanced(stateColored(ro), ro.multiDraw);
+        }
+
+        // Ескі жол: күй түсінде материал бөлікке бір рет қойылады
+        if (!gpu) beginLighting();
+        const bool byState = stateColored(ro);
+        for (int b = 0; b < kBuckets && !gpu; ++b) {
+            const int l = b / kStates;
+            if (byState && bucketStart[b + 1] > bucketStart[b]) Theme::setMaterialByState((NodeState)(b % kStates));
+            for (int k = bucketStart[b]; k < bucketStart[b + 1]; ++k) {
+                const int i = (int)instSlots[k];
+                const auto& n0 = graph.getNodes()[i];
+                if (!byState) {
+                    float rgb[3];
+                    slotColor(graph, ro, i, rgb);
+                    Theme::setMaterialRGB(rgb);
+                }
+                glPushMatrix();
+                glTranslatef(n0.pos.x, n0.pos.y, n0.pos.z);
+                drawSphere(slotRadius(ro, i), SphereLod::kStacks[l], SphereLod::kSlices[l]);
+                glPopMatrix();
+            }
+        }
+    }
+
+    // Жабық топтар — агрегат түсімен бір proxy сфера
+    proxyPosR.clear();
+    proxyColor.clear();
+    for (int g = 0; g < groups.size(); ++g) {
+        if (!groups.isProxy(g)) continue;
+        float rgb[3];
+        Theme::mixByCounts(groups[g].counts, rgb);
+        glm::vec3 c = groups.centroid(g);
+        float r = proxyRadius(groups[g]);
+        if (!cull.sphereVisible(c, r * 1.2f)) continue;
+        if (gpu) {
+            proxyPosR.insert(proxyPosR.end(),   { c.x, c.y, c.z, r });
+            proxyColor.insert(proxyColor.end(), { rgb[0], rgb[1], rgb[2], 1.0f });
+            continue;
+        }
+        Theme::setMaterialRGB(rgb);
         glPushMatrix();
-        glTranslatef(n0.pos.x, n0.pos.y, n0.pos.z);
-        drawSphere(kSphereR, 16, 22);
+        glTranslatef(c.x, c.y, c.z);
+        drawSphere(r, 16, 22);
         glPopMatrix();
+    }
+    if (gpu) drawMarkers(proxyPosR, proxyColor, 0, true);
+    else     endLighting();
+
+    drawImpact(graph, hoveredId, ro);
+
+    // Жарқылдар — жеке пост-өту: негізгі өтуде тармақ та, күй ауыстыру да жоқ
+    FrameProfiler::Scope halos(ro.profiler, "halos");
+    GpuTimer::Scope gpuHalos(ro.gpuTimer, "halos");
+    collectHighlights(graph, hoveredId, ro);
+    drawHighlights(gpu);
+}
+
+// Жарқылдар тізімі: ховер, таңдау, іздеу, маң, критикалық жол, әсер — құны O(саны)
+void GraphRenderer::collectHighlights(const Graph& graph, int hoveredId, const RenderOptions& ro) {
+    const auto& groups = graph.groups();
+    hlPosR.clear();
+    hlColor.clear();
+    auto add = [&](const glm::vec3& c, float r, const float* rgb, float a) {
+        hlPosR.insert(hlPosR.end(),   { c.x, c.y, c.z, r });
+        hlColor.insert(hlColor.end(), { rgb[0], rgb[1], rgb[2], a });
+    };
+    auto addSlots = [&](const std::vector<int>& list, float scale, const float* rgb, float a) {
+        for (int s : list)
+            if (s >= 0 && s < graph.count() && !groups.hidden(s) && cull.visible(s))
+                add(graph.getNodes()[s].pos, kSphereR * scale, rgb, a);
+    };
 
-        // Hover halo (қалауыңызша)
-        if (ro.haloHover && n0.id == hoveredId) {
-            glDisable(GL_LIGHTING);
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-            glColor4f(1.0f, 1.0f, 0.2f, 0.10f);
+    if (ro.showCritical) addSlots(graph.criticalPath(), 1.25f, Theme::CRIT, 0.18f);
+    if (ro.searchHits)   addSlots(*ro.searchHits, 1.4f, Theme::SEARCH, 0.16f);
+    if (ro.neighbourhood) addSlots(*ro.neighbourhood, 1.3f, Theme::NEIGH, 0.14f);
+    const int hs = graph.slotOf(hoveredId);
+    if (hs >= 0 && ro.impactDown && ro.impactUp) {
+        addSlots(*ro.impactDown, 1.3f, Theme::IMP_DN, 0.16f);
+        addSlots(*ro.impactUp,   1.3f, Theme::IMP_UP, 0.16f);
+    }
+    const int sel = graph.slotOf(ro.selectedId);
+    if (sel >= 0) addSlots({ sel }, 1.5f, Theme::SELECT, 0.14f);
+    if (ro.haloHover && hs >= 0) addSlots({ hs }, 1.35f, Theme::HOVER, 0.10f);
+    if (ro.haloHover && ro.hoveredGroup >= 0 && groups.isProxy(ro.hoveredGroup)) {
+        const float r = proxyRadius(groups[ro.hoveredGroup]) * 1.2f;
+        const glm::vec3 c = groups.centroid(ro.hoveredGroup);
+        if (cull.sphereVisible(c, r)) add(c, r, Theme::HOVER, 0.10f);
+    }
+}
+
+// Қосымша (additive) араластыру; тереңдік тексеріледі, бірақ жазылмайды —
+// бір-бірін жаппай қосылады. GPU-да бір instanced шақыру (marker, жарықсыз).
+void GraphRenderer::drawHighlights(bool gpu) {
+    if (hlPosR.empty()) return;
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+    if (gpu) {
+        drawMarkers(hlPosR, hlColor, kHaloLod, false);
+    } else {
+        glDisable(GL_LIGHTING);
+        for (size_t i = 0; i < hlPosR.size() / 4; ++i) {
+            const float* p = &hlPosR[i * 4];
+            glColor4fv(&hlColor[i * 4]);
             glPushMatrix();
-            glTranslatef(n0.pos.x, n0.pos.y, n0.pos.z);
-            // slightly larger sphere as glow
-            drawSphere(kSphereR*1.35f, 12, 18);
+            glTranslatef(p[0], p[1], p[2]);
+            drawSphere(p[3], SphereLod::kStacks[kHaloLod], SphereLod::kSlices[kHaloLod]);
             glPopMatrix();
-            glDisable(GL_BLEND);
-            beginLighting(); // restore
         }
     }
-
-    endLighting();
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
 }
@@ -1,21 +1,126 @@
 #pragma once
 #include "../core/graph.h"
 #include "../utils/camera.h"
+#include "../utils/shader.h"
+#include "../utils/frame_profiler.h"
+#include "../utils/gpu_timer.h"
+#include "sphere_mesh.h"
+#include "frustum_culler.h"
+#include "sphere_lod.h"
+#include "line_batch.h"
+#include "shader_manager.h"
+#include "gpu_blocks.h"
+#include <map>
+#include <memory>
+#include <cstdint>
 
 struct RenderOptions {
     bool showEdges   = true;
     bool showBounds  = true;
     bool haloHover   = true;
+    bool showCritical = true;
+    bool colorByShard = false;                      // түс — бөлік бойынша
+    const std::vector<float>* importance = nullptr; // slot → [0,1] (centrality)
+    bool importanceScale = true;                    // өлшемге
+    bool importanceColor = false;                   // түске (heat шкаласы)
+    const std::vector<int>* communityKey = nullptr; // slot → қауымдастық кілті (−1 жоқ)
+    bool instanced = true;                          // GPU инстанстау (шейдер болмаса — ескі жол)
+    bool cull = true;                               // frustum culling (өшірілсе — бәрі көрінеді)
+    bool impostors = false;                         // сфера орнына ray-cast квад (GPU жолында)
+    bool multiDraw = true;                          // MDI (қолдау болса), әйтпесе деңгей сайын instanced
+    int  selectedId = -1;                           // таңдалған тапсырма (жарқылмен)
+    const std::vector<int>* searchHits = nullptr;   // іздеу нәтижелері (slot-тар)
+    const std::vector<int>* neighbourhood = nullptr; // таңдаудың k-қадам маңы (slot-тар)
+    int  hoveredGroup = -1;
+    const std::vector<int>* impactDown = nullptr;   // ховердан кейінгі тапсырмалар
+    const std::vector<int>* impactUp   = nullptr;   // ховер тәуелді тапсырмалар
+    FrameProfiler* profiler = nullptr;              // өту (pass) бойынша CPU уақыты
+    GpuTimer* gpuTimer = nullptr;                   // өту бойынша GPU уақыты (кешіктіріліп оқылады)
 };
 
 class GraphRenderer {
 public:
+    GraphRenderer();
     void render(const Graph& graph, const Camera3D& cam, int w, int h,
                 int hoveredId, const RenderOptions& ro);
+
+    static float proxyRadius(const TaskGroup& g);
+    const FrustumCuller& culling() const { return cull; }   // соңғы кадрдың көрінетін жиыны
+    int lodInstances(int level) const { return bucketStart[(level + 1) * kStates] - bucketStart[level * kStates]; }
+    long long sphereVertices() const;                       // соңғы кадрда өңделген сфера төбелері
+    bool coreProfile() const { return core; }               // fixed-function жоқ (тек шейдер жолы)
+    bool multiDrawSupported() const { return mdiOk; }
+    int  sphereDrawCalls() const { return sphereDraws; }        // соңғы кадрдағы сфера шақырулары
+    ShaderManager&       shaderManager()       { return shaders; }
+    const ShaderManager& shaderManager() const { return shaders; }
 private:
     static void drawSphere(float r, int stacks, int slices);
+    static const SphereMesh& cachedSphere(int stacks, int slices);
     static void beginLighting();
     static void endLighting();
-    static void drawBounds(float B);
-    static void setColorByState(NodeState st);
+    void drawBounds(float B);
+    void drawImpact(const Graph& graph, int hoveredId, const RenderOptions& ro);
+    void collectHighlights(const Graph& graph, int hoveredId, const RenderOptions& ro);
+    void drawHighlights(bool gpu);
+    void drawMarkers(const std::vector<float>& posR, const std::vector<float>& rgba, int lod, bool lit);
+
+    // Инстанстау: slot-индекстелген орын/түс буферлері, бір draw call
+    bool initGpu();
+    void updateFrameBlock(const Camera3D& cam, int w, int h);
+    void uploadInstances(const Graph& graph, const RenderOptions& ro);
+    void assignBuckets(const Graph& graph, const Camera3D& cam, int h, const RenderOptions& ro);
+    void drawSpheresInstanced(bool byState, bool multiDraw);
+    void drawSpheresImpostor(bool byState);
+    void bindSphereInputs(const Shader& sh, bool byState);
+    void unbindSphereInputs();
+    static bool stateColored(const RenderOptions& ro);
+    void uploadEdges(const Graph& graph);           // тек топология өзгергенде
+    int  uploadCulledEdges(const Graph& graph);     // көрінетін ұшы бар қабырғалар
+    void drawEdgesIndexed(unsigned ibo, int count);
+    static void slotColor(const Graph& graph, const RenderOptions& ro, int slot, float rgb[3]);
+    static float slotRadius(const RenderOptions& ro, int slot);
+
+    ShaderManager shaders;                          // кэш + hot-reload; Shader* осыған тиесілі
+    bool gpuTried = false, gpuOk = false;
+    bool core = false;                              // контекст core profile-да
+    unsigned frameUbo = 0, materialsUbo = 0;        // gpu_blocks.h: Frame / Materials
+    LineBatch lines;                                // осьтер, шекара, критикалық жол, әсер
+    Shader* sphereShader = nullptr;
+    unsigned sphereVao = 0, sphereVbo = 0, sphereIbo = 0;
+    unsigned posBuf = 0, colorBuf = 0;              // slot сайын: vec4 (орын, радиус), RGBA8
+    unsigned posTex = 0, colorTex = 0;              // сол буферлер — samplerBuffer ретінде
+    unsigned instBuf = 0;                           // инстанс сайын: көрінетін slot | күй << kStateShift
+    unsigned indirectBuf = 0;                       // кадр сайын: бөлікке бір DrawElementsIndirect
+    bool mdiOk = false;
+    int sphereDraws = 0;
+    static constexpr unsigned kStateShift = 30;     // slot < 2^30
+    int lodFirst[SphereLod::kLevels] = {}, lodIndexCount[SphereLod::kLevels] = {};
+    // instSlots бөліктері: (деңгей, күй) → [bucketStart[b], bucketStart[b+1])
+    static constexpr int kStates  = StateIndex::kStates;
+    static constexpr int kBuckets = SphereLod::kLevels * kStates;
+    int bucketStart[kBuckets + 1] = {};
+    std::vector<unsigned char> lodOf;               // slot → алдыңғы кадр деңгейі (гистерезис үшін)
+    std::vector<int> lodOwner;                      // slot → lodOf иесінің id-і (slot ауысса — қалпына келеді)
+    Shader* impostorShader = nullptr;
+    unsigned impostorVao = 0, quadVbo = 0;
+    bool usedImpostors = false;                     // соңғы кадр (HUD төбе санағы үшін)
+    Shader* markerShader = nullptr;
+    unsigned markerVao = 0, markerPosBuf = 0, markerColorBuf = 0;
+    static constexpr int kHaloLod = 2;              // жарқылға орташа тор жеткілікті
+    std::vector<float> hlPosR, hlColor;             // жарқыл сайын: vec4 + RGBA
+    std::vector<float> proxyPosR, proxyColor;       // proxy сфералар (GPU жолында)
+    Shader* edgeShader = nullptr;
+    unsigned edgeVao = 0, edgeIbo = 0;              // GL_LINES: (from, to) slot жұптары, posBuf-ты оқиды
+    unsigned edgeCullIbo = 0;                       // culling кезінде: кадр сайынғы қысқа тізім
+    int edgeIndexCount = 0;
+    unsigned long long edgeTopo = ~0ull;            // индекс буферіндегі topologyVersion
+    std::vector<unsigned> edgeIdx, edgeCullIdx;
+    std::vector<unsigned> instSlots;                // көрінетін slot-тар, (LOD, күй) бойынша топталған
+    std::vector<unsigned> instPacked;               // GPU-ға: күй биттерімен
+    std::vector<GpuBlocks::DrawElementsIndirect> drawCmds;
+    FrustumCuller cull;
+    std::vector<float>    instPos;
+    std::vector<uint32_t> instColor;
+
+    std::vector<unsigned char> impactMark;   // slot → 1 төмен, 2 жоғары, 3 ховер
 };
@@ -0,0 +1,53 @@
+#include "line_batch.h"
+#include "gpu_blocks.h"
+#include <algorithm>
+
+bool LineBatch::init(ShaderManager& shaders) {
+    shader = shaders.load("line");
+    if (!shader->ok) { shader = nullptr; return false; }
+    shader->bindBlock("Frame", GpuBlocks::kFrameBinding);
+
+    GLfloat range[2] = { 1.0f, 1.0f };
+    glGetFloatv(GL_ALIASED_LINE_WIDTH_RANGE, range);
+    maxWidth = std::max(1.0f, range[1]);
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(3 * sizeof(float)));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void LineBatch::line(const glm::vec3& a, const glm::vec3& b, const float rgb[3], float alpha) {
+    verts.push_back({ a.x, a.y, a.z, rgb[0], rgb[1], rgb[2], alpha });
+    verts.push_back({ b.x, b.y, b.z, rgb[0], rgb[1], rgb[2], alpha });
+}
+
+void LineBatch::flush(float width) {
+    if (verts.empty()) return;
+    glLineWidth(std::min(width, maxWidth));
+    if (shader) {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(Vertex), verts.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        shader->use();
+        glBindVertexArray(vao);
+        glDrawArrays(GL_LINES, 0, (GLsizei)verts.size());
+        glBindVertexArray(0);
+        glUseProgram(0);
+    } else {
+        glBegin(GL_LINES);
+        for (const auto& v : verts) {
+            glColor4f(v.r, v.g, v.b, v.a);
+            glVertex3f(v.x, v.y, v.z);
+        }
+        glEnd();
+    }
+    verts.clear();
+}
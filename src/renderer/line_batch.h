@@ -0,0 +1,23 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include "shader_manager.h"
+
+// Түсті сызықтар жинағы (осьтер, шекара, критикалық жол, әсер қабырғалары).
+// Шейдер бар болса — бір VBO + бір draw call (core profile), әйтпесе
+// ескі glBegin(GL_LINES) жолы. Матрицалар `Frame` UBO-дан алынады.
+class LineBatch {
+public:
+    bool init(ShaderManager& shaders);              // false → glBegin жолы
+    void line(const glm::vec3& a, const glm::vec3& b, const float rgb[3], float alpha);
+    void flush(float width);                        // сызып, тазалайды
+    bool empty() const { return verts.empty(); }
+
+private:
+    struct Vertex { float x, y, z, r, g, b, a; };
+    std::vector<Vertex> verts;
+    Shader* shader = nullptr;
+    unsigned vao = 0, vbo = 0;
+    float maxWidth = 1.0f;                          // драйвер рұқсат еткен ең қалың сызық
+};
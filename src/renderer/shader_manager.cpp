@@ -0,0 +1,205 @@
+#include "shader_manager.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// FNV-1a; ұзындық та араласады — ("ab","c") ≠ ("a","bc")
+uint64_t hashStr(uint64_t h, const std::string& s) {
+    for (unsigned char c : s) { h ^= c; h *= 0x100000001b3ull; }
+    h ^= (uint64_t)s.size();
+    return h * 0x100000001b3ull;
+}
+
+long long mtime(const std::string& path) {
+    std::error_code ec;
+    auto t = fs::last_write_time(path, ec);
+    return ec ? 0 : (long long)t.time_since_epoch().count();
+}
+
+std::string glStr(GLenum e) {
+    const char* s = (const char*)glGetString(e);
+    return s ? s : "";
+}
+
+} // namespace
+
+ShaderManager::ShaderManager(std::string dir_, std::string cacheDir_)
+    : dir(std::move(dir_)), cacheDir(std::move(cacheDir_)) {
+#ifdef __linux__
+    // Редакторлар не орнында жазады (CLOSE_WRITE), не уақытша файлды ауыстырады (MOVED_TO)
+    watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watchFd >= 0 && inotify_add_watch(watchFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(watchFd);
+        watchFd = -1;
+    }
+#endif
+}
+
+ShaderManager::~ShaderManager() {
+#ifdef __linux__
+    if (watchFd >= 0) close(watchFd);
+#endif
+}
+
+Shader* ShaderManager::load(const std::string& name) {
+    for (auto& p : programs)
+        if (p->name == name) return p->sh.get();
+
+    // Драйвер жолы мен бинарлы формат қолдауы — алғашқы жүктеуде (контекст бар)
+    if (!driverKnown) {
+        driverKnown = true;
+        driver = glStr(GL_VENDOR) + "|" + glStr(GL_RENDERER) + "|" + glStr(GL_VERSION);
+        GLint formats = 0;
+        if (GLAD_GL_VERSION_4_1 || GLAD_GL_ARB_get_program_binary) glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        std::error_code ec;
+        binaryOk = formats > 0 && !cacheDir.empty() && (fs::create_directories(cacheDir, ec), !ec);
+    }
+
+    auto p = std::make_unique<Program>();
+    p->name = name;
+    p->sh = std::make_unique<Shader>();
+    const double t0 = timeline ? timeline->now() : 0.0;
+    bool cached = false;
+    p->sh->adopt(build(*p, cached));
+    p->sh->log = p->error;
+    if (timeline) timeline->add("shader " + name + (cached ? " (cache)" : " (compile)"), t0, timeline->now() - t0);
+    programs.push_back(std::move(p));
+    rebuildErrors();
+    return programs.back()->sh.get();
+}
+
+// Алдымен бинарлы кэш, болмаса бастапқы мәтіннен (және кэшке жазу)
+unsigned ShaderManager::build(Program& p, bool& fromCache) {
+    fromCache = false;
+    const std::string vPath = sourcePath(p.name, ".vert"), fPath = sourcePath(p.name, ".frag");
+    p.vTime = mtime(vPath);
+    p.fTime = mtime(fPath);
+    const std::string vCode = Shader::readFile(vPath.c_str()), fCode = Shader::readFile(fPath.c_str());
+
+    std::string prefix, path;
+    if (binaryOk && !vCode.empty() && !fCode.empty()) {
+        uint64_t h = 0xcbf29ce484222325ull;
+        h = hashStr(h, vCode);
+        h = hashStr(h, fCode);
+        h = hashStr(h, driver);
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)h);
+        prefix = p.name + "-";
+        path = cacheDir + "/" + prefix + hex + ".bin";
+        if (unsigned id = loadBinary(path)) {
+            ++hits;
+            fromCache = true;
+            p.error.clear();
+            return id;
+        }
+        ++misses;
+    }
+
+    std::string log;
+    unsigned id = Shader::build(vCode, fCode, log, binaryOk);
+    p.error = log;
+    if (!id) std::cerr << "Shader '" << p.name << "' failed: " << log << "\n";
+    else if (binaryOk) storeBinary(path, prefix, id);
+    return id;
+}
+
+// Файл: [uint32 формат][драйвер бинары]. Драйвер қабылдамаса — 0 (қайта компиляция)
+unsigned ShaderManager::loadBinary(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return 0;
+    std::vector<char> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (data.size() <= sizeof(uint32_t)) return 0;
+    uint32_t format = 0;
+    std::memcpy(&format, data.data(), sizeof(format));
+    unsigned id = glCreateProgram();
+    glProgramBinary(id, (GLenum)format, data.data() + sizeof(format), (GLsizei)(data.size() - sizeof(format)));
+    GLint linked = 0;
+    glGetProgramiv(id, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        glDeleteProgram(id);
+        return 0;
+    }
+    return id;
+}
+
+// Сол программаның ескі нұсқалары өшіріледі; уақытша файл + rename — жартылай жазылған кэш оқылмайды
+void ShaderManager::storeBinary(const std::string& path, const std::string& prefix, unsigned program) {
+    GLint len = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &len);
+    if (len <= 0) return;
+    std::vector<char> data(sizeof(uint32_t) + (size_t)len);
+    GLenum format = 0;
+    glGetProgramBinary(program, len, nullptr, &format, data.data() + sizeof(uint32_t));
+    const uint32_t f32 = format;
+    std::memcpy(data.data(), &f32, sizeof(f32));
+
+    std::error_code ec;
+    for (const auto& e : fs::directory_iterator(cacheDir, ec))
+        if (e.path().filename().string().compare(0, prefix.size(), prefix) == 0) fs::remove(e.path(), ec);
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        if (!out.write(data.data(), (std::streamsize)data.size())) return;
+    }
+    fs::rename(tmp, path, ec);
+}
+
+// Сәтсіз болса ескі программа қалады — экран бос болмайды
+void ShaderManager::reload(Program& p) {
+    bool cached = false;
+    unsigned id = build(p, cached);
+    if (id) {
+        p.sh->adopt(id);
+        ++reloadCount;
+    } else {
+        p.sh->log = p.error;
+    }
+    rebuildErrors();
+}
+
+void ShaderManager::poll() {
+    std::set<std::string> changed;
+#ifdef __linux__
+    if (watchFd >= 0) {
+        alignas(inotify_event) char buf[4096];
+        ssize_t n;
+        while ((n = read(watchFd, buf, sizeof(buf))) > 0) {
+            for (char* q = buf; q < buf + n; ) {
+                const auto* ev = (const inotify_event*)q;
+                if (ev->len) changed.insert(fs::path(ev->name).stem().string());
+                q += sizeof(inotify_event) + ev->len;
+            }
+        }
+    }
+#endif
+    if (watchFd < 0) {
+        // inotify жоқ: жарты секундта бір mtime салыстыру
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastScan < std::chrono::milliseconds(500)) return;
+        lastScan = now;
+        for (const auto& p : programs)
+            if (mtime(sourcePath(p->name, ".vert")) != p->vTime || mtime(sourcePath(p->name, ".frag")) != p->fTime)
+                changed.insert(p->name);
+    }
+    if (changed.empty()) return;
+    for (auto& p : programs)
+        if (changed.count(p->name)) reload(*p);
+}
+
+void ShaderManager::rebuildErrors() {
+    errs.clear();
+    for (const auto& p : programs)
+        if (!p->error.empty()) errs.push_back({ p->name, p->error });
+}
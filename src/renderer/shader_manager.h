@@ -0,0 +1,61 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../utils/shader.h"
+#include "../utils/startup_timeline.h"
+
+// Шейдер программалары: <dir>/<name>.vert + .frag.
+// - Бинарлы кэш: сәтті байланыстырылған программа glGetProgramBinary арқылы
+//   <cacheDir>-ға жазылады; кілт — екі бастапқы мәтін + драйвер жолдары
+//   (vendor/renderer/version) хэші. Драйвер не мәтін өзгерсе — кэш жай өтеді.
+// - Hot-reload: Linux-та inotify, басқа жерде mtime. Қайта құру сәтсіз болса
+//   ескі программа қалады, қате errors()-та (UI көрсетеді).
+// Shader* көрсеткіштері менеджер өмір сүргенше тұрақты — reload тек ID-ды ауыстырады.
+class ShaderManager {
+public:
+    struct Error {
+        std::string program;
+        std::string log;
+    };
+
+    ShaderManager(std::string dir, std::string cacheDir);
+    ~ShaderManager();
+    ShaderManager(const ShaderManager&) = delete;
+    ShaderManager& operator=(const ShaderManager&) = delete;
+
+    Shader* load(const std::string& name);          // әрқашан көрсеткіш; сәтсіз болса ok = false
+    void poll();                                    // кадр сайын: өзгерген файлдар → қайта құру
+
+    const std::vector<Error>& errors() const { return errs; }
+    int  cacheHits() const   { return hits; }
+    int  cacheMisses() const { return misses; }
+    int  reloads() const     { return reloadCount; }
+    bool binaryCache() const { return binaryOk; }
+    void setTimeline(StartupTimeline* t) { timeline = t; }
+
+private:
+    struct Program {
+        std::string name;
+        std::unique_ptr<Shader> sh;
+        std::string error;
+        long long vTime = 0, fTime = 0;             // mtime (inotify жоқ жерде)
+    };
+
+    unsigned build(Program& p, bool& fromCache);
+    unsigned loadBinary(const std::string& path);
+    void storeBinary(const std::string& path, const std::string& prefix, unsigned program);
+    void reload(Program& p);
+    void rebuildErrors();
+    std::string sourcePath(const std::string& name, const char* ext) const { return dir + "/" + name + ext; }
+
+    std::string dir, cacheDir, driver;
+    std::vector<std::unique_ptr<Program>> programs;
+    std::vector<Error> errs;
+    StartupTimeline* timeline = nullptr;
+    bool binaryOk = false, driverKnown = false;
+    int hits = 0, misses = 0, reloadCount = 0;
+    int watchFd = -1;                               // inotify (−1 → mtime жолы)
+    std::chrono::steady_clock::time_point lastScan{};
+};
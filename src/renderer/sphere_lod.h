@@ -0,0 +1,28 @@
+#pragma once
+
+// Сфера LOD деңгейлері: экрандағы радиус (пиксель) бойынша таңдалады.
+// Гистерезис: шекарадан ±kHyst шықпайынша деңгей ауыспайды (жыпылықтамас үшін).
+struct SphereLod {
+    static constexpr int kLevels = 4;
+    static constexpr int   kStacks[kLevels] = { 16, 10, 6, 4 };
+    static constexpr int   kSlices[kLevels] = { 22, 14, 9, 6 };
+    static constexpr float kMinPx[kLevels]  = { 24.0f, 8.0f, 3.0f, 0.0f };   // l деңгейі: px ≥ kMinPx[l]
+    static constexpr float kHyst = 0.2f;
+    static constexpr unsigned char kNone = 0xFF;
+
+    static int level(float px, float scale) {
+        int l = 0;
+        while (l < kLevels - 1 && px < kMinPx[l] * scale) ++l;
+        return l;
+    }
+
+    // prev — алдыңғы кадрдағы деңгей (kNone — жоқ)
+    static int select(int prev, float px) {
+        if (prev >= kLevels) return level(px, 1.0f);
+        const int finer   = level(px, 1.0f + kHyst);   // нақтылауға — шек жоғарырақ
+        const int coarser = level(px, 1.0f - kHyst);   // дөрекілеуге — шек төменірек
+        if (prev > finer)   return finer;
+        if (prev < coarser) return coarser;
+        return prev;
+    }
+};
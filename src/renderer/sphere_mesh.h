@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include <cmath>
+
+// Бірлік сфера: индекстелген үшбұрыштар тізімі (нормаль = позиция).
+// Бір рет құрылып, VBO/IBO-ға немесе client array-ге беріледі.
+struct SphereMesh {
+    std::vector<float>    pos;      // xyz
+    std::vector<unsigned> idx;
+    int stacks = 0, slices = 0;
+
+    static SphereMesh build(int stacks, int slices) {
+        SphereMesh m;
+        m.stacks = stacks;
+        m.slices = slices;
+        const float PI = 3.14159265358979323846f;
+        for (int i = 0; i <= stacks; ++i) {
+            float t = PI * (float)i / stacks;
+            for (int j = 0; j <= slices; ++j) {
+                float phi = 2.0f * PI * (float)j / slices;
+                m.pos.push_back(std::sin(t) * std::cos(phi));
+                m.pos.push_back(std::cos(t));
+                m.pos.push_back(std::sin(t) * std::sin(phi));
+            }
+        }
+        const unsigned row = (unsigned)slices + 1;
+        for (int i = 0; i < stacks; ++i) {
+            for (int j = 0; j < slices; ++j) {
+                unsigned a = i * row + j, b = a + row;
+                m.idx.insert(m.idx.end(), { a, b, a + 1, a + 1, b, b + 1 });
+            }
+        }
+        return m;
+    }
+
+    int vertexCount() const { return (int)pos.size() / 3; }
+};
@@ -4,6 +4,9 @@
 #include <glm/gtc/type_ptr.hpp>
 #include "../core/graph.h"
 #include "../utils/camera.h"
+#include "../utils/frame_profiler.h"
+#include "../utils/startup_timeline.h"
+#include "../renderer/graph_renderer.h"
 #include "../ui/theme.h"
 
 // World→Screen проекциясы (көрінсе true)
@@ -19,22 +22,92 @@ inline bool worldToScreen(const glm::vec3& P, const Camera3D& cam, int w, int h,
     return true;
 }
 
-inline void drawLegendAndStats(const Graph& g) {
+inline void drawLegendAndStats(const Graph& g, const FrameProfiler* prof = nullptr,
+                               const GraphRenderer* r = nullptr, const GpuTimer* gpu = nullptr) {
     ImGui::Begin("Legend / Stats", nullptr,
         ImGuiWindowFlags_NoResize | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings);
     ImGui::Text("Nodes: %d", g.count());
+    ImGui::Text("Version: %llu  (history %d)", g.version(), (int)g.history().size());
     ImGui::Separator();
-    ImGui::TextColored(ImVec4(Theme::N_PEN[0], Theme::N_PEN[1], Theme::N_PEN[2],1),"Pending");
-    ImGui::TextColored(ImVec4(Theme::N_DON[0], Theme::N_DON[1], Theme::N_DON[2],1),"Done");
-    ImGui::TextColored(ImVec4(Theme::N_FAI[0], Theme::N_FAI[1], Theme::N_FAI[2],1),"Fail");
+    ImGui::TextColored(ImVec4(Theme::N_PEN[0], Theme::N_PEN[1], Theme::N_PEN[2],1),"Pending: %d", g.countByState(NodeState::Pending));
+    ImGui::TextColored(ImVec4(Theme::N_DON[0], Theme::N_DON[1], Theme::N_DON[2],1),"Done:    %d", g.countByState(NodeState::Done));
+    ImGui::TextColored(ImVec4(Theme::N_FAI[0], Theme::N_FAI[1], Theme::N_FAI[2],1),"Fail:    %d", g.countByState(NodeState::Fail));
+    ImGui::Separator();
+    ImGui::TextColored(ImVec4(Theme::CRIT[0], Theme::CRIT[1], Theme::CRIT[2],1),
+        "Critical path: %d tasks, %.1f s", (int)g.criticalPath().size(), g.makespan());
+    const auto& sh = g.partition();
+    if (sh.parts() > 1) {
+        ImGui::Separator();
+        ImGui::Text("Shards: %d  cut edges: %d", sh.parts(), sh.cutEdges());
+        for (int p = 0; p < sh.parts(); ++p) {
+            ImGui::TextColored(ImVec4(Theme::SHARD[p % 8][0], Theme::SHARD[p % 8][1], Theme::SHARD[p % 8][2], 1), "%d", sh.partSize(p));
+            if (p + 1 < sh.parts()) ImGui::SameLine();
+        }
+    }
     ImGui::Separator();
     ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
+    if (r && r->culling().total() > 0) {
+        const auto& cull = r->culling();
+        ImGui::Text("Visible: %d / %d  (cells %d)", cull.visibleCount(), cull.total(), cull.cellsTested());
+        ImGui::Text("LOD: %d / %d / %d / %d  (%.1fk verts)", r->lodInstances(0), r->lodInstances(1),
+                    r->lodInstances(2), r->lodInstances(3), r->sphereVertices() / 1000.0);
+        ImGui::Text("Sphere draws: %d", r->sphereDrawCalls());
+    }
+    // Өту сайын уақыт (мс, жылжымалы орташа): CPU — жіберу, GPU — орындау
+    const FrameProfiler* gp = (gpu && gpu->supported()) ? &gpu->results() : nullptr;
+    if (prof) {
+        ImGui::Text("%-8s %9s %9s", "pass", "cpu", gp ? "gpu" : "");
+        for (const auto& s : prof->sections()) {
+            const FrameProfiler::Section* gs = gp ? gp->find(s.name) : nullptr;
+            if (gs) ImGui::Text("%-8s %6.2f ms %6.2f ms", s.name, s.avgMs, gs->avgMs);
+            else    ImGui::Text("%-8s %6.2f ms", s.name, s.avgMs);
+        }
+    }
+    if (gp) {
+        // Тек GPU-да өлшенетін өтулер (мысалы ImGui)
+        for (const auto& s : gp->sections())
+            if (!prof || !prof->find(s.name))
+                ImGui::Text("%-8s %9s %6.2f ms", s.name, "", s.avgMs);
+    } else if (gpu) {
+        ImGui::TextDisabled("GPU timers: n/a");
+    }
+    ImGui::End();
+}
+
+// Шейдер қателері (бар болса — бөлек терезе) және іске қосылу уақыт сызығы
+inline void drawShaderPanel(const ShaderManager& sm, const StartupTimeline& tl) {
+    if (!sm.errors().empty()) {
+        ImGui::Begin("Shader errors");
+        for (const auto& e : sm.errors()) {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.35f, 1.0f), "%s", e.program.c_str());
+            ImGui::TextWrapped("%s", e.log.c_str());
+            ImGui::Separator();
+        }
+        ImGui::TextDisabled("Fix the file and save — it reloads automatically.");
+        ImGui::End();
+    }
+
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Startup", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    for (const auto& s : tl.spans())
+        ImGui::Text("%8.1f  %7.2f ms  %s", s.startMs, s.durMs, s.name.c_str());
+    ImGui::Separator();
+    if (sm.binaryCache()) ImGui::Text("Program cache: %d hit / %d miss", sm.cacheHits(), sm.cacheMisses());
+    else                  ImGui::TextDisabled("Program cache: unsupported");
+    ImGui::Text("Hot reloads: %d", sm.reloads());
     ImGui::End();
 }
 
-inline void drawLabelsOverlay(const Graph& g, const Camera3D& cam, int w, int h, int hoveredId) {
+// cull берілсе — тек көрінетін slot-тар проекцияланады
+inline void drawLabelsOverlay(const Graph& g, const Camera3D& cam, int w, int h, int hoveredId,
+                              const FrustumCuller* cull = nullptr) {
     auto* draw = ImGui::GetForegroundDrawList();
-    for (const auto& n : g.getNodes()) {
+    const auto& groups = g.groups();
+    const int count = cull ? cull->visibleCount() : g.count();
+    for (int k = 0; k < count; ++k) {
+        const int i = cull ? cull->slots()[k] : k;
+        if (groups.hidden(i)) continue;
+        const auto& n = g.getNodes()[i];
         ImVec2 pt;
         if (!worldToScreen(n.pos, cam, w, h, pt)) continue;
         // Ховер болса – ашықтау фон
@@ -44,8 +117,10 @@ inline void drawLabelsOverlay(const Graph& g, const Camera3D& cam, int w, int h,
             (n.state==NodeState::Pending)?"Pending":
             (n.state==NodeState::Done)   ?"Done":
             (n.state==NodeState::Fail)   ?"Fail":"Neutral";
-        char buf[64];
-        snprintf(buf, sizeof(buf), "#%d  %s", n.id, stateTxt);
+        char buf[96];
+        std::string_view name = g.nameOf(i);
+        if (name.empty()) snprintf(buf, sizeof(buf), "#%d  %s", n.id, stateTxt);
+        else              snprintf(buf, sizeof(buf), "%.*s  %s", (int)name.size(), name.data(), stateTxt);
         ImVec2 sz = ImGui::CalcTextSize(buf);
         ImVec2 pad(6,3);
         ImVec2 p0(pt.x - sz.x*0.5f - pad.x, pt.y - 18 - pad.y);
@@ -53,4 +128,36 @@ inline void drawLabelsOverlay(const Graph& g, const Camera3D& cam, int w, int h,
         draw->AddRectFilled(p0, p1, bg, 6.0f);
         draw->AddText(ImVec2(p0.x+pad.x, p0.y+pad.y), fg, buf);
     }
+
+    // Жабық топтар: атауы мен агрегаттары
+    for (int gi = 0; gi < groups.size(); ++gi) {
+        if (!groups.isProxy(gi)) continue;
+        ImVec2 pt;
+        if (!worldToScreen(groups.centroid(gi), cam, w, h, pt)) continue;
+        const auto& tg = groups[gi];
+        char buf[96];
+        snprintf(buf, sizeof(buf), "%s %d  %d tasks  P%d D%d F%d",
+                 tg.level == 0 ? "Job" : "Stage", gi, tg.total,
+                 tg.counts[(int)NodeState::Pending], tg.counts[(int)NodeState::Done],
+                 tg.counts[(int)NodeState::Fail]);
+        ImVec2 sz = ImGui::CalcTextSize(buf);
+        ImVec2 pad(6,3);
+        ImVec2 p0(pt.x - sz.x*0.5f - pad.x, pt.y - 26 - pad.y);
+        ImVec2 p1(pt.x + sz.x*0.5f + pad.x, pt.y - 26 + sz.y + pad.y);
+        draw->AddRectFilled(p0, p1, Theme::colU32(0.1f,0.2f,0.4f,0.55f), 6.0f);
+        draw->AddText(ImVec2(p0.x+pad.x, p0.y+pad.y), IM_COL32_WHITE, buf);
+    }
+}
+
+// Ховердағы тапсырманың барлық атрибуттары (бағаналы қоймадан)
+inline void drawInspector(const Graph& g, int hoveredId) {
+    int s = g.slotOf(hoveredId);
+    if (s < 0) return;
+    const auto& A = g.attributes();
+    ImGui::BeginTooltip();
+    ImGui::Text("#%d", hoveredId);
+    for (int c = 0; c < A.columnCount(); ++c)
+        ImGui::Text("%s: %s", A.columnName(c).c_str(), A.format(c, s).c_str());
+    ImGui::Text("duration: %.1f s", g.critical().duration(s));
+    ImGui::EndTooltip();
 }
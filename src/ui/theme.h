@@ -1,5 +1,6 @@
 #pragma once
 #include <imgui.h>
+#include <cmath>
 
 // ImGui және OpenGL материал түстері (state → color)
 namespace Theme {
@@ -13,28 +14,81 @@ namespace Theme {
     static constexpr float N_PEN[3] = {1.00f, 1.00f, 0.00f};
     static constexpr float N_DON[3] = {0.00f, 1.00f, 0.00f};
     static constexpr float N_FAI[3] = {1.00f, 0.00f, 0.00f};
+    static constexpr float CRIT[3]  = {1.00f, 0.55f, 0.10f}; // критикалық жол
+    static constexpr float IMP_DN[3] = {1.00f, 0.35f, 0.35f}; // бөгелген ұрпақтар
+    static constexpr float IMP_UP[3] = {0.35f, 0.65f, 1.00f}; // тәуелді аталар
+    static constexpr float HOVER[3]  = {1.00f, 1.00f, 0.20f}; // ховер жарқылы
+    static constexpr float SELECT[3] = {1.00f, 1.00f, 1.00f}; // таңдалған тапсырма
+    static constexpr float SEARCH[3] = {0.20f, 1.00f, 0.90f}; // іздеу нәтижелері
+    static constexpr float NEIGH[3]  = {0.75f, 0.55f, 1.00f}; // таңдаудың k-қадам маңы
+
+    // Шард палитрасы (colorByShard режимі)
+    static constexpr float SHARD[8][3] = {
+        {0.90f, 0.35f, 0.35f}, {0.35f, 0.70f, 0.95f}, {0.45f, 0.85f, 0.40f}, {0.95f, 0.75f, 0.30f},
+        {0.70f, 0.45f, 0.90f}, {0.30f, 0.85f, 0.80f}, {0.95f, 0.50f, 0.80f}, {0.65f, 0.65f, 0.65f},
+    };
 
     // Material intensities
     static constexpr float DIF[4] = {0.90f, 0.90f, 0.92f, 1.0f};
     static constexpr float EM0[4] = {0.00f, 0.00f, 0.00f, 1.0f};
     static constexpr float AMB[4] = {0.20f, 0.20f, 0.22f, 1.0f}; // сәл көтеріңкі
     static constexpr float SPC[4] = {0.18f, 0.18f, 0.18f, 1.0f};
+    static constexpr float SHININESS = 24.0f;                   // орташа жылтырау
 
-    inline void setMaterialByState(NodeState st) {
-        float dif[4];
+    inline const float* stateColor(NodeState st) {
         switch (st) {
-            case NodeState::Neutral: dif[0]=N_NEU[0]; dif[1]=N_NEU[1]; dif[2]=N_NEU[2]; break;
-            case NodeState::Pending: dif[0]=N_PEN[0]; dif[1]=N_PEN[1]; dif[2]=N_PEN[2]; break;
-            case NodeState::Done:    dif[0]=N_DON[0]; dif[1]=N_DON[1]; dif[2]=N_DON[2]; break;
-            case NodeState::Fail:    dif[0]=N_FAI[0]; dif[1]=N_FAI[1]; dif[2]=N_FAI[2]; break;
+            case NodeState::Pending: return N_PEN;
+            case NodeState::Done:    return N_DON;
+            case NodeState::Fail:    return N_FAI;
+            default:                 return N_NEU;
+        }
+    }
+
+    // Кілттен тұрақты ашық түс (қауымдастықтар үшін): алтын қима бойынша реңк
+    inline void keyColor(int key, float out[3]) {
+        float h = std::fmod((float)(unsigned)key * 0.61803398875f, 1.0f) * 6.0f;
+        float x = 1.0f - std::fabs(std::fmod(h, 2.0f) - 1.0f);
+        float r = 0, g = 0, b = 0;
+        switch ((int)h) {
+            case 0: r = 1; g = x; break;   case 1: r = x; g = 1; break;
+            case 2: g = 1; b = x; break;   case 3: g = x; b = 1; break;
+            case 4: r = x; b = 1; break;   default: r = 1; b = x; break;
         }
-        dif[3] = 1.0f;
+        out[0] = 0.25f + 0.7f * r; out[1] = 0.25f + 0.7f * g; out[2] = 0.25f + 0.7f * b;
+    }
+
+    // Маңыздылық шкаласы (0 — салқын көк, 1 — ыстық қызыл-сары)
+    inline void heat(float t, float out[3]) {
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        out[0] = 0.20f + 0.80f * t;
+        out[1] = 0.35f + 0.55f * t * (1.0f - t) * 2.0f;
+        out[2] = 0.90f * (1.0f - t);
+    }
+
+    // Топ агрегаттары бойынша салмақталған түс
+    inline void mixByCounts(const int counts[4], float out[3]) {
+        int total = counts[0] + counts[1] + counts[2] + counts[3];
+        out[0] = out[1] = out[2] = 0.0f;
+        if (total == 0) { out[0]=N_NEU[0]; out[1]=N_NEU[1]; out[2]=N_NEU[2]; return; }
+        for (int s = 0; s < 4; ++s) {
+            const float* c = stateColor((NodeState)s);
+            float w = (float)counts[s] / (float)total;
+            out[0] += c[0]*w; out[1] += c[1]*w; out[2] += c[2]*w;
+        }
+    }
+
+    inline void setMaterialRGB(const float rgb[3]) {
+        float dif[4] = { rgb[0], rgb[1], rgb[2], 1.0f };
 
         glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT,  AMB);
         glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE,  dif);
         glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, SPC);
-        glMaterialf (GL_FRONT_AND_BACK, GL_SHININESS, 24.0f); // орташа жылтырау
+        glMaterialf (GL_FRONT_AND_BACK, GL_SHININESS, SHININESS);
         static constexpr float EM0[4] = {0,0,0,1};
         glMaterialfv(GL_FRONT_AND_BACK, GL_EMISSION, EM0);
     }
+
+    inline void setMaterialByState(NodeState st) {
+        setMaterialRGB(stateColor(st));
+    }
 }
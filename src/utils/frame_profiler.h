@@ -0,0 +1,64 @@
+#pragma once
+#include <chrono>
+#include <vector>
+#include <cstring>
+
+// Кадр профайлері: аталған бөлімдердің CPU уақыты (соңғы + жылжымалы орташа).
+// GL шақырулары үшін бұл тек жіберу (submission) құны — GPU уақыты емес.
+// Scope-қа nullptr берілсе — өлшеу жоқ (профайлер қосылмаған).
+class FrameProfiler {
+public:
+    struct Section {
+        const char* name;
+        double lastMs = 0.0, avgMs = 0.0;
+        double totalMs = 0.0;           // reset()-тен бергі қосынды (бенчмарк орташасы үшін)
+        long   samples = 0;
+        double meanMs() const { return samples ? totalMs / samples : 0.0; }
+    };
+
+    class Scope {
+    public:
+        Scope(FrameProfiler* p, const char* name)
+            : prof(p), idx(p ? p->index(name) : -1), t0(std::chrono::steady_clock::now()) {}
+        ~Scope() {
+            if (!prof) return;
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            prof->add(idx, ms);
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        FrameProfiler* prof;
+        int idx;
+        std::chrono::steady_clock::time_point t0;
+    };
+
+    const std::vector<Section>& sections() const { return list; }
+    const Section* find(const char* name) const {
+        for (const auto& s : list)
+            if (s.name == name || std::strcmp(s.name, name) == 0) return &s;
+        return nullptr;
+    }
+    // Қыздырудан кейін: жинақталған мәндерді тазалау (бөлімдер сақталады)
+    void reset() { for (auto& s : list) s = Section{ s.name }; }
+    // Сырттан өлшенген уақыт (мысалы GPU сұранысы — gpu_timer.h)
+    void record(const char* name, double ms) { add(index(name), ms); }
+    double smoothing = 0.05;            // EMA коэффициенті
+
+private:
+    int index(const char* name) {
+        for (int i = 0; i < (int)list.size(); ++i)
+            if (list[i].name == name || std::strcmp(list[i].name, name) == 0) return i;
+        list.push_back({ name });
+        return (int)list.size() - 1;
+    }
+    void add(int i, double ms) {
+        Section& s = list[i];
+        s.avgMs  = (s.lastMs == 0.0 && s.avgMs == 0.0) ? ms : s.avgMs + (ms - s.avgMs) * smoothing;
+        s.lastMs = ms;
+        s.totalMs += ms;
+        ++s.samples;
+    }
+
+    std::vector<Section> list;
+};
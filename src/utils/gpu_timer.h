@@ -0,0 +1,95 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstring>
+#include <vector>
+#include "frame_profiler.h"
+
+// GPU уақыты: өту сайын GL_TIME_ELAPSED сұранысы. Нәтиже бірнеше кадрдан
+// кейін ғана оқылады (kRing сақина) — GL_QUERY_RESULT_AVAILABLE тексеріледі,
+// сондықтан CPU ешқашан GPU-ды күтпейді. Сақина толса — сол кадр өлшенбейді.
+// Таймер қолдамайтын драйверде (counter bits = 0, мысалы кейбір бағдарламалық
+// GL) бәрі no-op, supported() = false.
+// TIME_ELAPSED сұраныстары кірістірілмейді: ішкі Scope белсенді болса — өткізіледі.
+class GpuTimer {
+public:
+    static constexpr int kRing = 4;
+
+    class Scope {
+    public:
+        Scope(GpuTimer* t, const char* name) : timer(t ? t->begin(name) : nullptr) {}
+        ~Scope() { if (timer) timer->end(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        GpuTimer* timer;
+    };
+
+    // Кадр басында: дайын нәтижелерді жинау (GL контексті керек; алғашқы шақыруда init)
+    void beginFrame() {
+        if (!tried) init();
+        if (!ok) return;
+        for (auto& s : list)
+            for (int k = 0; k < kRing; ++k) collect(s, k);
+        ++frame;
+    }
+
+    bool supported() const { return ok; }
+    void resetStats() { sink.reset(); }
+    const FrameProfiler& results() const { return sink; }   // мс, жылжымалы орташа
+
+private:
+    struct Section {
+        const char* name;
+        unsigned ids[kRing] = {};
+        bool pending[kRing] = {};
+    };
+
+    void init() {
+        tried = true;
+        if (!(GLAD_GL_VERSION_3_3 || GLAD_GL_ARB_timer_query)) return;
+        GLint bits = 0;
+        glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &bits);
+        ok = bits > 0;
+    }
+
+    GpuTimer* begin(const char* name) {
+        if (!ok || active) return nullptr;
+        Section& s = list[index(name)];
+        const int k = (int)(frame % kRing);
+        if (s.pending[k] && !collect(s, k)) return nullptr;    // әлі дайын емес — күтпейміз
+        glBeginQuery(GL_TIME_ELAPSED, s.ids[k]);
+        s.pending[k] = true;
+        active = true;
+        return this;
+    }
+    void end() {
+        glEndQuery(GL_TIME_ELAPSED);
+        active = false;
+    }
+
+    // Дайын болса — нәтижені sink-ке; true → слот бос
+    bool collect(Section& s, int k) {
+        if (!s.pending[k]) return true;
+        GLint ready = 0;
+        glGetQueryObjectiv(s.ids[k], GL_QUERY_RESULT_AVAILABLE, &ready);
+        if (!ready) return false;
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(s.ids[k], GL_QUERY_RESULT, &ns);
+        s.pending[k] = false;
+        sink.record(s.name, ns * 1e-6);
+        return true;
+    }
+
+    int index(const char* name) {
+        for (int i = 0; i < (int)list.size(); ++i)
+            if (list[i].name == name || std::strcmp(list[i].name, name) == 0) return i;
+        list.push_back({ name });
+        glGenQueries(kRing, list.back().ids);
+        return (int)list.size() - 1;
+    }
+
+    std::vector<Section> list;
+    FrameProfiler sink;
+    unsigned long long frame = 0;
+    bool tried = false, ok = false, active = false;
+};
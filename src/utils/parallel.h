@@ -0,0 +1,94 @@
+#pragma once
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+inline int workerCount() {
+    return (int)std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Тұрақты жіптер пулы: жіптер бір рет жасалады (thread_local күйі де
+// бір рет), әр parallelFor жай кезекке тапсырма қояды.
+// Шақырушы жіп тапсырмаға өзі де қатысады — пул бос емес болса да
+// (фондық талдау, ішкі parallelFor) жұмыс тоқтап қалмайды.
+class WorkerPool {
+public:
+    static WorkerPool& instance() {
+        static WorkerPool pool(workerCount() - 1);
+        return pool;
+    }
+
+    template <class F>
+    void run(int n, F& f) {
+        Job job;
+        job.n = n;
+        job.ctx = (void*)&f;
+        job.call = [](void* ctx, int i) { (*static_cast<F*>(ctx))(i); };
+        {
+            std::lock_guard<std::mutex> lk(mx);
+            queue.push_back(&job);
+        }
+        cv.notify_all();
+        job.work();
+        // Барлық индекс таратылды; тапсырманы алған жіптер аяқтағанша күтеміз
+        std::unique_lock<std::mutex> lk(mx);
+        auto it = std::find(queue.begin(), queue.end(), &job);
+        if (it != queue.end()) queue.erase(it);
+        doneCv.wait(lk, [&] { return job.users == 0; });
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lk(mx);
+            quit = true;
+        }
+        cv.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+private:
+    struct Job {
+        int n = 0;
+        std::atomic<int> next{ 0 };
+        int users = 0;                          // mx астында
+        void* ctx = nullptr;
+        void (*call)(void*, int) = nullptr;
+        void work() { for (int i; (i = next++) < n; ) call(ctx, i); }
+    };
+
+    explicit WorkerPool(int count) {
+        for (int w = 0; w < count; ++w) threads.emplace_back([this] { loop(); });
+    }
+
+    void loop() {
+        std::unique_lock<std::mutex> lk(mx);
+        for (;;) {
+            cv.wait(lk, [&] { return quit || !queue.empty(); });
+            if (quit) return;
+            Job* j = queue.front();
+            if (j->next.load() >= j->n) { queue.pop_front(); continue; }   // таратылып біткен
+            ++j->users;
+            lk.unlock();
+            j->work();
+            lk.lock();
+            if (--j->users == 0) doneCv.notify_all();
+        }
+    }
+
+    std::mutex mx;
+    std::condition_variable cv, doneCv;
+    std::deque<Job*> queue;
+    bool quit = false;
+    std::vector<std::thread> threads;           // соңғы: loop() жоғарыдағы өрістерді қолданады
+};
+
+// Fork-join: [0, n) тапсырмаларын пул жіптеріне динамикалық бөледі
+template <class F>
+inline void parallelFor(int n, F&& f) {
+    if (n <= 1 || workerCount() <= 1) { for (int i = 0; i < n; ++i) f(i); return; }
+    WorkerPool::instance().run(n, f);
+}
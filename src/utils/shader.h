@@ -1,5 +1,7 @@
 #pragma once
 #include <string>
+#include <vector>
+#include <utility>
 #include <glad/glad.h>
 #include <fstream>
 #include <sstream>
@@ -7,31 +9,102 @@
 
 class Shader {
 public:
-    unsigned int ID;
+    unsigned int ID = 0;
+    bool ok = false;            // компиляция/байланыстыру сәтті болды ма
+    std::string log;            // соңғы сәтсіздік мәтіні (UI үшін)
+
+    Shader() = default;
     Shader(const char* vPath, const char* fPath) {
-        std::string vCode, fCode;
-        std::ifstream vFile(vPath), fFile(fPath);
-        std::stringstream vs, fs;
-        vs << vFile.rdbuf(); fs << fFile.rdbuf();
-        vCode = vs.str(); fCode = fs.str();
-
-        unsigned int vShader = compile(GL_VERTEX_SHADER, vCode.c_str());
-        unsigned int fShader = compile(GL_FRAGMENT_SHADER, fCode.c_str());
-        ID = glCreateProgram();
-        glAttachShader(ID, vShader);
-        glAttachShader(ID, fShader);
-        glLinkProgram(ID);
-        glDeleteShader(vShader);
-        glDeleteShader(fShader);
+        std::string vCode = readFile(vPath), fCode = readFile(fPath);
+        ID = build(vCode, fCode, log, false);
+        ok = ID != 0;
+        if (!ok) std::cerr << "Shader failed (" << vPath << ", " << fPath << "): " << log << "\n";
     }
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
 
     void use() const { glUseProgram(ID); }
 
+    void setMat4(const char* name, const float* m) const { glUniformMatrix4fv(glGetUniformLocation(ID, name), 1, GL_FALSE, m); }
+    void setVec3(const char* name, float x, float y, float z) const { glUniform3f(glGetUniformLocation(ID, name), x, y, z); }
+    void setVec4(const char* name, float x, float y, float z, float w) const { glUniform4f(glGetUniformLocation(ID, name), x, y, z, w); }
+    void setInt(const char* name, int v) const { glUniform1i(glGetUniformLocation(ID, name), v); }
+
+    // std140 uniform блогын binding нүктесіне бекіту (блок жоқ болса — ештеңе).
+    // Есте сақталады: қайта жүктелген программаға adopt() қайта қолданады.
+    void bindBlock(const char* name, unsigned binding) {
+        for (auto& b : blocks)
+            if (b.first == name) { b.second = binding; applyBlock(b); return; }
+        blocks.emplace_back(name, binding);
+        applyBlock(blocks.back());
+    }
+
+    // Жаңа байланыстырылған программаны алу (hot-reload): ескісі жойылады
+    void adopt(unsigned int program) {
+        if (ID && ID != program) glDeleteProgram(ID);
+        ID = program;
+        ok = program != 0;
+        log.clear();
+        for (const auto& b : blocks) applyBlock(b);
+    }
+
+    static std::string readFile(const char* path) {
+        std::ifstream f(path);
+        std::stringstream ss;
+        ss << f.rdbuf();
+        return ss.str();
+    }
+
+    // Компиляция + байланыстыру; сәтсіз болса 0 және log толтырылады.
+    // retrievable → glGetProgramBinary үшін (бинарлы кэш)
+    static unsigned int build(const std::string& vCode, const std::string& fCode, std::string& log, bool retrievable) {
+        log.clear();
+        if (vCode.empty() || fCode.empty()) { log = "missing shader source"; return 0; }
+        unsigned int vShader = compile(GL_VERTEX_SHADER, vCode.c_str(), "vertex", log);
+        unsigned int fShader = compile(GL_FRAGMENT_SHADER, fCode.c_str(), "fragment", log);
+        unsigned int id = glCreateProgram();
+        glAttachShader(id, vShader);
+        glAttachShader(id, fShader);
+        if (retrievable) glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(id);
+        glDeleteShader(vShader);
+        glDeleteShader(fShader);
+
+        GLint linked = 0;
+        glGetProgramiv(id, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            char buf[1024] = {};
+            glGetProgramInfoLog(id, sizeof(buf), nullptr, buf);
+            log += "link: ";
+            log += buf;
+            glDeleteProgram(id);
+            return 0;
+        }
+        return id;
+    }
+
 private:
-    static unsigned int compile(GLenum type, const char* src) {
+    std::vector<std::pair<std::string, unsigned>> blocks;
+
+    void applyBlock(const std::pair<std::string, unsigned>& b) const {
+        if (!ID) return;
+        unsigned idx = glGetUniformBlockIndex(ID, b.first.c_str());
+        if (idx != GL_INVALID_INDEX) glUniformBlockBinding(ID, idx, b.second);
+    }
+
+    static unsigned int compile(GLenum type, const char* src, const char* stage, std::string& log) {
         unsigned int shader = glCreateShader(type);
         glShaderSource(shader, 1, &src, nullptr);
         glCompileShader(shader);
+        GLint status = 0;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+        if (!status) {
+            char buf[1024] = {};
+            glGetShaderInfoLog(shader, sizeof(buf), nullptr, buf);
+            log += stage;
+            log += ": ";
+            log += buf;
+        }
         return shader;
     }
 };
@@ -0,0 +1,32 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Іске қосылу уақыт сызығы: аралықтар процесс басынан (объект жасалған сәттен)
+// мс-пен. Ішкі аралықтар (мысалы шейдерлер бірінші кадр ішінде) жай қосыла береді.
+class StartupTimeline {
+public:
+    struct Span {
+        std::string name;
+        double startMs, durMs;
+    };
+
+    double now() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - origin).count();
+    }
+    void add(std::string name, double startMs, double durMs) { list.push_back({ std::move(name), startMs, durMs }); }
+    // Сызықтық код үшін: алдыңғы mark()-тан осы сәтке дейінгі аралық
+    void mark(std::string name) {
+        const double t = now();
+        add(std::move(name), last, t - last);
+        last = t;
+    }
+    const std::vector<Span>& spans() const { return list; }     // аяқталу реті бойынша
+
+private:
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    std::vector<Span> list;
+    double last = 0.0;
+};
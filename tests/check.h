@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdio>
+
+// Ең қарапайым тексеру: сәтсіздік жазылады, тест жалғасады; main() CHECK_RESULT() қайтарады
+static int gCheckFailures = 0;
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ++gCheckFailures;                                                   \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_RESULT() (gCheckFailures == 0 ? 0 : (std::fprintf(stderr, "%d check(s) failed\n", gCheckFailures), 1))
@@ -0,0 +1,56 @@
+// Louvain жылы старты: тапсырмалар жойылғаннан кейінгі белгілер (n-нен үлкен)
+#include "check.h"
+#include "core/graph.h"
+#include "core/communities.h"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+static std::shared_ptr<const CommunityResult> settle(CommunityWorker& w, const Graph& g) {
+    w.request(g);
+    while (w.busy()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return w.latest();
+}
+
+static bool validLabels(const CommunityResult& r, int n) {
+    if ((int)r.comm.size() != n || r.count > n || (int)r.key.size() != r.count) return false;
+    for (int c : r.comm) if (c < 0 || c >= r.count) return false;
+    return true;
+}
+
+// Тізбек: Louvain көп қауымдастық береді, жойылғаннан кейін ескі белгілер n-нен асады
+static void warmStartAfterRemovals() {
+    Graph g(0);
+    std::vector<int> ids;
+    for (int i = 0; i < 40; ++i) ids.push_back(g.addTask(i ? std::vector<int>{ ids.back() } : std::vector<int>{}, 1.0f));
+
+    CommunityWorker w;
+    auto r0 = settle(w, g);
+    CHECK(r0 && validLabels(*r0, g.count()));
+    CHECK(r0->count > 3);
+
+    for (int i = 0; i < 37; ++i) g.removeTask(ids[i]);
+    auto r1 = settle(w, g);
+    CHECK(r1 && r1 != r0);
+    CHECK(validLabels(*r1, g.count()));
+}
+
+// Тікелей шақыру: сирек үлкен белгілер де 0..k-1-ге жиналады
+static void sparseLabels() {
+    Graph g(0);
+    int a = g.addTask({}, 1.0f), b = g.addTask({ a }, 1.0f);
+    g.addTask({ b }, 1.0f);
+    Csr out, in;
+    buildCsr(g.getEdges(), g.count(), out, in);
+    std::vector<int> comm{ 1000, 1000, 70 };
+    Communities::louvain(out, in, comm);
+    CHECK(comm.size() == 3);
+    for (int c : comm) CHECK(c >= 0 && c < 3);
+}
+
+int main() {
+    warmStartAfterRemovals();
+    sparseLabels();
+    return CHECK_RESULT();
+}
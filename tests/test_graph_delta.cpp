@@ -0,0 +1,114 @@
+// Дельта: encode → apply айналымы, негіз нұсқасын тексеру, операция қателері, журнал шегі
+#include "check.h"
+#include "core/graph.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using EdgeIds = std::vector<std::pair<int, int>>;
+
+static EdgeIds edgeIds(const Graph& g) {
+    EdgeIds out;
+    const auto& N = g.getNodes();
+    for (const auto& e : g.getEdges()) out.push_back({ N[e.from].id, N[e.to].id });
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+static bool sameGraph(const Graph& a, const Graph& b) {
+    if (a.ids() != b.ids() || edgeIds(a) != edgeIds(b)) return false;
+    for (int id : a.ids()) {
+        const Node& x = a.getNodes()[a.slotOf(id)];
+        const Node& y = b.getNodes()[b.slotOf(id)];
+        if (x.state != y.state || x.basePos != y.basePos) return false;
+    }
+    return true;
+}
+
+static DeltaApplyResult ship(const Graph& src, unsigned long long from, Graph& dst) {
+    std::vector<uint8_t> buf;
+    CHECK(encodeDelta(src, from, src.version(), buf));
+    return applyDelta(dst, buf.data(), buf.size());
+}
+
+static void roundTrip() {
+    Graph src(0), dst(0);
+    std::vector<int> ids;
+    for (int i = 0; i < 30; ++i) {
+        std::vector<int> deps;
+        if (i > 0) deps.push_back(ids[i / 2]);
+        if (i > 3) deps.push_back(ids[i - 3]);
+        ids.push_back(src.addTask(deps, 1.0f + i % 4));
+    }
+    src.setNodeState(ids[3], NodeState::Done);
+    src.setNodeState(ids[7], NodeState::Fail);
+
+    auto r = ship(src, 0, dst);
+    CHECK(r.ok());
+    CHECK(dst.version() == src.version());
+    CHECK(sameGraph(src, dst));
+
+    // Келесі дельта алдыңғы нұсқадан басталады
+    const auto v1 = src.version();
+    src.removeTask(ids[5]);
+    src.removeDependency(ids[4], ids[8]);
+    CHECK(src.addDependency(ids[2], ids[29]) == DepStatus::Added);
+    // Қабылданбағандар журналға түспейді — дельтада да жоқ
+    CHECK(src.addDependency(ids[2], ids[29]) == DepStatus::Duplicate);
+    CHECK(src.addDependency(ids[29], ids[2]) == DepStatus::Cycle);
+    CHECK(src.addDependency(ids[5], ids[2]) == DepStatus::MissingId);
+    src.setNodeState(ids[10], NodeState::Neutral);
+    const size_t journalBefore = src.history().size();
+    CHECK(src.markSubtree(ids[1], NodeState::Fail) > 1);
+    CHECK(src.history().size() == journalBefore + 1);                    // бір StateBatch жазбасы
+    r = ship(src, v1, dst);
+    CHECK(r.ok());
+    CHECK(r.fromVer == v1 && r.toVer == src.version());
+    CHECK(dst.version() == src.version());
+    CHECK(sameGraph(src, dst));
+
+    // Сол дельта қайта келсе — негіз сәйкес емес, граф өзгермейді
+    std::vector<uint8_t> buf;
+    CHECK(encodeDelta(src, v1, src.version(), buf));
+    const auto before = dst.version();
+    CHECK(applyDelta(dst, buf.data(), buf.size()).status == DeltaApplyResult::Status::BaseMismatch);
+    CHECK(dst.version() == before);
+
+    // Қиылған дельта — бұзық пішім
+    CHECK(applyDelta(dst, buf.data(), buf.size() - 1).status == DeltaApplyResult::Status::Malformed);
+}
+
+// Нұсқасы сәйкес, бірақ мазмұны басқа граф: қолданылмаған операциялар аталады
+static void failedOps() {
+    Graph src(0), dst(0);
+    int a = src.addTask({}, 1.0f);
+    dst.restoreTask(a + 100, 1.0f, glm::vec3(0.0f), NodeState::Pending);
+    const auto v = src.version();
+    CHECK(dst.version() == v);
+    src.setNodeState(a, NodeState::Done);
+    int b = src.addTask({ a }, 2.0f);
+    (void)b;
+
+    auto r = ship(src, v, dst);
+    CHECK(r.status == DeltaApplyResult::Status::OpsFailed);
+    // [0] State(a) — a жоқ; [1] AddNode(b) — өтеді; [2] AddEdge(a→b) — a жоқ
+    CHECK((r.failedOps == std::vector<int>{ 0, 2 }));
+}
+
+static void historyLimit() {
+    Graph g(0);
+    g.setHistoryLimit(8);
+    for (int i = 0; i < 40; ++i) g.addTask({}, 1.0f);
+    CHECK(g.history().size() < 16);
+    CHECK(g.history().back().version == g.version());
+    std::vector<uint8_t> buf;
+    CHECK(!encodeDelta(g, 0, g.version(), buf));                    // басы тасталған
+    CHECK(encodeDelta(g, g.version() - 4, g.version(), buf));
+}
+
+int main() {
+    roundTrip();
+    failedOps();
+    historyLimit();
+    return CHECK_RESULT();
+}